@@ -148,7 +148,8 @@ public:
             std::string systusOptionAnalysis="auto", std::string systusOutputProduct="systus",
             std::vector< std::vector<int> > systusSubcases = {},
             std::string systusOutputMatrix="table", int systusSizeMatrix=9,
-            std::string systusDynamicMethod="direct");
+            std::string systusDynamicMethod="direct", bool finishReport = false,
+            int asterNodeGroupSize = 1000);
     const ModelConfiguration getModelConfiguration() const;
     virtual ~ConfigurationParameters();
 
@@ -184,6 +185,17 @@ public:
      * Choice of Dynamic method : either a direct or a modal one
      */
     const std::string systusDynamicMethod;
+    /**
+     * Write the statistics of the passes of Model::finish() in a JSON file next to the output,
+     * see Model::writeFinishReport
+     */
+    const bool finishReport;
+    /**
+     * Node lists of Code_Aster constraints with at least this number of nodes are written
+     * as MED node groups and referenced by GROUP_NO in the .comm file, instead of being
+     * enumerated node by node. 0 always enumerates the nodes.
+     */
+    const int asterNodeGroupSize;
 };
 
 }
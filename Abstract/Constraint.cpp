@@ -303,7 +303,7 @@ set<int> SinglePointConstraint::nodePositions() const {
     if (group != nullptr) {
         if (this->group->type == Group::NODEGROUP) {
             NodeGroup* const ngroup = static_cast<NodeGroup* const >(group);
-            set<int> nodePositions = ngroup->nodePositions();
+            const set<int> nodePositions = ngroup->nodePositions();
             result.insert(nodePositions.begin(), nodePositions.end());
         } else {
             throw logic_error("SPC:: getAllNodes on unknown group type");
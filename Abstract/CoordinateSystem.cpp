@@ -53,19 +53,37 @@ ostream &operator<<(ostream &out, const CoordinateSystem& coordinateSystem) {
 }
 
 const VectorialValue CoordinateSystem::getEulerAnglesIntrinsicZYX(const CoordinateSystem *rcs) const {
-    double ax, ay, az = 0;
-    VectorialValue EX, EY, EZ;
-
     if (rcs== nullptr){
-        EX = this->ex;
-        EY = this->ey;
-        EZ = this->ez;
-    }else{
-        EX = rcs->vectorToLocal(this->ex);
-        EY = rcs->vectorToLocal(this->ey);
-        EZ = rcs->vectorToLocal(this->ez);
+        return eulerAnglesIntrinsicZYX(this->ex, this->ey, this->ez);
     }
-
+    return eulerAnglesIntrinsicZYX(rcs->vectorToLocal(this->ex), rcs->vectorToLocal(this->ey),
+            rcs->vectorToLocal(this->ez));
+}
+
+const VectorialValue CoordinateSystem::getEulerAnglesIntrinsicZYX(const VectorialValue& rex,
+        const VectorialValue& rey) const {
+    // Same base and inverse matrix as a built CartesianCoordinateSystem(rex, rey)
+    const VectorialValue rx = rex.normalized();
+    const VectorialValue ry = rey.orthonormalized(rx);
+    const VectorialValue rz = rx.cross(ry);
+    ublas::matrix<double> m(3, 3);
+    m(0,0)= rx.x() ; m(0,1)= ry.x() ; m(0,2)= rz.x() ;
+    m(1,0)= rx.y() ; m(1,1)= ry.y() ; m(1,2)= rz.y() ;
+    m(2,0)= rx.z() ; m(2,1)= ry.z() ; m(2,2)= rz.z() ;
+    ublas::matrix<double> inverse(3, 3);
+    InvertMatrix(m, inverse);
+    auto toLocal = [&inverse](const VectorialValue& global) {
+        double x = global.x() * inverse(0,0) + global.y() * inverse(0,1) + global.z() * inverse(0,2);
+        double y = global.x() * inverse(1,0) + global.y() * inverse(1,1) + global.z() * inverse(1,2);
+        double z = global.x() * inverse(2,0) + global.y() * inverse(2,1) + global.z() * inverse(2,2);
+        return VectorialValue(x, y, z);
+    };
+    return eulerAnglesIntrinsicZYX(toLocal(this->ex), toLocal(this->ey), toLocal(this->ez));
+}
+
+const VectorialValue CoordinateSystem::eulerAnglesIntrinsicZYX(const VectorialValue& EX,
+        const VectorialValue& EY, const VectorialValue& EZ) {
+    double ax, ay, az = 0;
     double cy = sqrt(EZ.z() * EZ.z() + EY.z() * EY.z());
     if (cy > 1e-8) {
         ax = atan2(EX.y(), EX.x());
@@ -78,6 +96,15 @@ const VectorialValue CoordinateSystem::getEulerAnglesIntrinsicZYX(const Coordina
     return VectorialValue(ax, ay, az);
 }
 
+void CoordinateSystem::positionsToGlobal(size_t count, const double* lx, const double* ly,
+        const double* lz, double* x, double* y, double* z) const {
+    for (size_t i = 0; i < count; i++) {
+        const VectorialValue global = positionToGlobal(VectorialValue(lx[i], ly[i], lz[i]));
+        x[i] = global.x();
+        y[i] = global.y();
+        z[i] = global.z();
+    }
+}
 
 CartesianCoordinateSystem::CartesianCoordinateSystem(const Model& model,
         const VectorialValue& origin, const VectorialValue& ex, const VectorialValue& ey,
@@ -97,6 +124,21 @@ const VectorialValue CartesianCoordinateSystem::positionToGlobal(const Vectorial
     return (this->getOrigin()+vectorToGlobal(local));
 }
 
+void CartesianCoordinateSystem::positionsToGlobal(size_t count, const double* lx,
+        const double* ly, const double* lz, double* x, double* y, double* z) const {
+    // base and origin in locals, so that the loop only reads and writes the arrays.
+    // The sums are grouped as in positionToGlobal to get the very same values.
+    const double ox = origin.x(), oy = origin.y(), oz = origin.z();
+    const double exx = ex.x(), exy = ex.y(), exz = ex.z();
+    const double eyx = ey.x(), eyy = ey.y(), eyz = ey.z();
+    const double ezx = ez.x(), ezy = ez.y(), ezz = ez.z();
+    for (size_t i = 0; i < count; i++) {
+        x[i] = ox + (lx[i] * exx + ly[i] * eyx + lz[i] * ezx);
+        y[i] = oy + (lx[i] * exy + ly[i] * eyy + lz[i] * ezy);
+        z[i] = oz + (lx[i] * exz + ly[i] * eyz + lz[i] * ezz);
+    }
+}
+
 const VectorialValue CartesianCoordinateSystem::vectorToGlobal(const VectorialValue& local) const {
     double x = local.x() * ex.x() + local.y() * ey.x() + local.z() * ez.x();
     double y = local.x() * ex.y() + local.y() * ey.y() + local.z() * ez.y();
@@ -166,6 +208,22 @@ const VectorialValue CylindricalCoordinateSystem::positionToGlobal(const Vectori
     return (this->getOrigin()+VectorialValue(x,y,z));
 }
 
+void CylindricalCoordinateSystem::positionsToGlobal(size_t count, const double* lx,
+        const double* ly, const double* lz, double* x, double* y, double* z) const {
+    const double ox = origin.x(), oy = origin.y(), oz = origin.z();
+    const double exx = ex.x(), exy = ex.y(), exz = ex.z();
+    const double eyx = ey.x(), eyy = ey.y(), eyz = ey.z();
+    const double ezx = ez.x(), ezy = ez.y(), ezz = ez.z();
+    for (size_t i = 0; i < count; i++) {
+        const double theta = M_PI * ly[i] / 180.0;
+        const double rcosth = lx[i] * cos(theta);
+        const double rsinth = lx[i] * sin(theta);
+        x[i] = ox + (rcosth * exx + rsinth * eyx + lz[i] * ezx);
+        y[i] = oy + (rcosth * exy + rsinth * eyy + lz[i] * ezy);
+        z[i] = oz + (rcosth * exz + rsinth * eyz + lz[i] * ezz);
+    }
+}
+
 const VectorialValue CylindricalCoordinateSystem::vectorToGlobal(
         const VectorialValue& local) const {
     double x = local.x() * ur.x() + local.y() * utheta.x() + local.z() * ez.x();
@@ -71,6 +71,9 @@ class CoordinateSystem: public Identifiable<CoordinateSystem> {
     inline const VectorialValue getEz() const {return ez;};
 
     protected:
+    /** Euler Angles of the base (EX, EY, EZ), see getEulerAnglesIntrinsicZYX(). **/
+    static const VectorialValue eulerAnglesIntrinsicZYX(const VectorialValue& EX, const VectorialValue& EY,
+            const VectorialValue& EZ);
     CoordinateSystem(const Model&, Type, const VectorialValue origin, const VectorialValue ex,
             const VectorialValue ey, int original_id = NO_ORIGINAL_ID);
     public:
@@ -83,6 +86,12 @@ class CoordinateSystem: public Identifiable<CoordinateSystem> {
      *   to its global counterpart.
      **/
     virtual const VectorialValue positionToGlobal(const VectorialValue&) const = 0;
+    /**
+     *  Same as positionToGlobal for count positions given as separate lx, ly, lz arrays,
+     *   results are written in the x, y, z arrays.
+     **/
+    virtual void positionsToGlobal(size_t count, const double* lx, const double* ly,
+            const double* lz, double* x, double* y, double* z) const;
     /**
      *  Translate a vector, expressed in this local Coordinate system,
      *   to its global counterpart. Warning, it does not take the origin into
@@ -101,6 +110,11 @@ class CoordinateSystem: public Identifiable<CoordinateSystem> {
      *  coordinate system is used. 
      **/
     virtual const VectorialValue getEulerAnglesIntrinsicZYX(const CoordinateSystem *rcs = nullptr) const;
+    /**
+     *  Same as above, the reference coordinate system being the cartesian one of axes
+     *  (rex, rey). No CoordinateSystem is built, so it may be called from any thread.
+     **/
+    const VectorialValue getEulerAnglesIntrinsicZYX(const VectorialValue& rex, const VectorialValue& rey) const;
     virtual std::shared_ptr<CoordinateSystem> clone() const = 0;
 };
 
@@ -118,6 +132,8 @@ public:
      **/
     void build() override;
     const VectorialValue positionToGlobal(const VectorialValue&) const override;
+    void positionsToGlobal(size_t count, const double* lx, const double* ly, const double* lz,
+            double* x, double* y, double* z) const override;
     const VectorialValue vectorToGlobal(const VectorialValue&) const override;
     const VectorialValue vectorToLocal(const VectorialValue&) const override;
     std::shared_ptr<CoordinateSystem> clone() const override;
@@ -175,6 +191,8 @@ class CylindricalCoordinateSystem: public CoordinateSystem {
      *   to its global counterpart (x,y,z). theta is expressed in degrees.
      **/
     const VectorialValue positionToGlobal(const VectorialValue&) const override;
+    void positionsToGlobal(size_t count, const double* lx, const double* ly, const double* lz,
+            double* x, double* y, double* z) const override;
     /**
      *  Translate a vector, expressed in this coordinate system (ur, utheta, uz),
      *   to its global counterpart. Warning, it does not take the origin into
@@ -272,64 +272,78 @@ DOFMatrix::DOFMatrix(bool symmetric) : symmetric(symmetric) {
 
 }
 
+/* DOF by position, to iterate without copying DOFs. */
+static const DOF* const DOF_BY_POSITION[6] = { &DOF::DX, &DOF::DY, &DOF::DZ, &DOF::RX, &DOF::RY, &DOF::RZ };
+
+/* Components whose row or column is a translation (resp. rotation). */
+static const bitset<36> TRANSLATION_COMPONENTS("000111000111000111111111111111111111");
+static const bitset<36> ROTATION_COMPONENTS("111111111111111111111000111000111000");
+static const bitset<36> DIAGONAL_COMPONENTS("100000010000001000000100000010000001");
+
+DOFMatrix::iterator::iterator(size_t _index, const DOFMatrix *matrix) :
+		index(_index), outer_matrix(matrix) {
+	next_defined_component();
+}
+
+void DOFMatrix::iterator::next_defined_component() {
+	while (index < 36 && !outer_matrix->definedComponents.test(index)) {
+		index++;
+	}
+}
+
+DOFMatrix::iterator::value_type DOFMatrix::iterator::operator*() const {
+	return value_type(pair<const DOF&, const DOF&>(*DOF_BY_POSITION[index / 6], *DOF_BY_POSITION[index % 6]),
+			outer_matrix->values[index]);
+}
+
+DOFMatrix::iterator DOFMatrix::begin() const {
+	return DOFMatrix::iterator(0, this);
+}
+
+DOFMatrix::iterator DOFMatrix::end() const {
+	return DOFMatrix::iterator(36, this);
+}
+
 void DOFMatrix::addComponent(const DOF dof1, const DOF dof2, const double value) {
 	if (symmetric && dof1 > dof2) {
-		componentByDofs[make_pair(dof2, dof1)] = value;
+		setComponent(dof2, dof1, value);
 	} else {
-		componentByDofs[make_pair(dof1, dof2)] = value;
+		setComponent(dof1, dof2, value);
+	}
+}
+
+void DOFMatrix::setComponent(const DOF& dof1, const DOF& dof2, const double value) {
+	if (values.empty()) {
+		values.resize(36, 0.0);
 	}
+	const size_t index = componentIndex(dof1, dof2);
+	values[index] = value;
+	definedComponents.set(index);
 }
 
 double DOFMatrix::findComponent(const DOF dof1, const DOF dof2) const {
 	if (symmetric && dof1 > dof2) {
-		auto it = componentByDofs.find(make_pair(dof2, dof1));
-		if (it != componentByDofs.end()) {
-			return it->second;
-		}
-	} else {
-		auto it = componentByDofs.find(make_pair(dof1, dof2));
-		if (it != componentByDofs.end()) {
-			return it->second;
-		}
+		return getComponent(dof2, dof1);
 	}
-	return 0;
+	return getComponent(dof1, dof2);
 }
 
 bool DOFMatrix::hasRotations() const {
-	bool hasRotations = false;
-	for (auto& kv : componentByDofs) {
-		DOF dof1 = kv.first.first;
-		DOF dof2 = kv.first.second;
-		if (dof1.isRotation or dof2.isRotation) {
-			hasRotations = true;
-			break;
-		}
-	}
-	return hasRotations;
+	return (definedComponents & ROTATION_COMPONENTS).any();
 }
 
 bool DOFMatrix::hasTranslations() const {
-	bool hasTranslations = false;
-	for (auto& kv : componentByDofs) {
-		DOF dof1 = kv.first.first;
-		DOF dof2 = kv.first.second;
-		if (dof1.isTranslation or dof2.isTranslation) {
-			hasTranslations = true;
-			break;
-		}
-	}
-	return hasTranslations;
+	return (definedComponents & TRANSLATION_COMPONENTS).any();
 }
 
 bool DOFMatrix::isDiagonal() const {
-	bool isDiagonal = true;
-	for (auto& kv : componentByDofs) {
-		if (kv.first.first != kv.first.second and !is_equal(kv.second, 0)) {
-			isDiagonal = false;
-			break;
+	const bitset<36> offDiagonal = definedComponents & ~DIAGONAL_COMPONENTS;
+	for (size_t index = 0; index < 36; index++) {
+		if (offDiagonal.test(index) and !is_equal(values[index], 0)) {
+			return false;
 		}
 	}
-	return isDiagonal;
+	return true;
 }
 
 bool DOFMatrix::isSymmetric() const {
@@ -337,7 +351,11 @@ bool DOFMatrix::isSymmetric() const {
 }
 
 bool DOFMatrix::isEmpty() const {
-	return componentByDofs.empty();
+	return definedComponents.none();
+}
+
+size_t DOFMatrix::size() const {
+	return definedComponents.count();
 }
 
 }
@@ -16,6 +16,8 @@
 #include <boost/bimap.hpp>
 #include <unordered_map>
 #include <set>
+#include <bitset>
+#include <vector>
 
 namespace vega {
 
@@ -148,21 +150,80 @@ DOFS operator-(const DOFS lhs, const DOF& rhs);
 std::ostream &operator<<(std::ostream &out, const DOFS& dofs);
 std::ostream &operator<<(std::ostream &out, const DOFS::iterator& dofs_iter);
 
-/* Sparse matrix between two dofs (of the same node), or the same dof with itself.*/
+/* Sparse matrix between two dofs (of the same node), or the same dof with itself.
+ * Components are stored in a dense 6x6 block, allocated with the first component,
+ * and a mask tells which of them are defined. */
 class DOFMatrix final {
 private:
 		bool symmetric;
+		std::bitset<36> definedComponents;
+		std::vector<double> values;
+		static size_t componentIndex(const DOF& dof1, const DOF& dof2) {
+			return static_cast<size_t>(6 * dof1.position + dof2.position);
+		}
 public:
-		std::unordered_map<std::pair<DOF, DOF>, double,
-				boost::hash<std::pair<int, int>>>componentByDofs;
 		DOFMatrix(bool it2 = false);
+		/**
+		 * Iterates over the defined components, by row DOF then column DOF.
+		 * Dereferencing gives ((row DOF, column DOF), value).
+		 */
+		class iterator: public std::iterator<std::input_iterator_tag,
+				std::pair<std::pair<const DOF&, const DOF&>, double>> {
+		private:
+			size_t index;
+			const DOFMatrix *outer_matrix;
+			void next_defined_component();
+		public:
+			iterator(size_t index, const DOFMatrix *outer_matrix);
+
+			bool operator==(const iterator& x) const {
+				return index == x.index;
+			}
+
+			bool operator!=(const iterator& x) const {
+				return !(*this == x);
+			}
+
+			value_type operator*() const;
+
+			iterator& operator++() {
+				index++;
+				next_defined_component();
+				return *this;
+			}
+		};
+		iterator begin() const;
+		iterator end() const;
+		/**
+		 * Sets a component. In a symmetric matrix, only the upper triangle is stored.
+		 */
 		void addComponent(const DOF dof1, const DOF dof2, const double value);
+		/**
+		 * Sets a component exactly where it is asked, even in a symmetric matrix.
+		 */
+		void setComponent(const DOF& dof1, const DOF& dof2, const double value);
 		double findComponent(const DOF dof1, const DOF dof2) const;
+		/**
+		 * True if the component was set, without looking at the symmetric component.
+		 */
+		bool hasComponent(const DOF& dof1, const DOF& dof2) const {
+			return definedComponents.test(componentIndex(dof1, dof2));
+		}
+		/**
+		 * Value of the component, without looking at the symmetric component (0 if not set).
+		 */
+		double getComponent(const DOF& dof1, const DOF& dof2) const {
+			return hasComponent(dof1, dof2) ? values[componentIndex(dof1, dof2)] : 0;
+		}
 		bool hasTranslations() const;
 		bool hasRotations() const;
 		bool isDiagonal() const;
 		bool isSymmetric() const;
 		bool isEmpty() const;
+		/**
+		 * Number of defined components.
+		 */
+		size_t size() const;
 };
 
 } /* namespace vega */
@@ -303,14 +303,7 @@ vector<double> DiscretePoint::asVector(bool addRotationsIfNotPresent) {
 	int ncomp = (addRotationsIfNotPresent || hasRotations()) ? 6 : 3;
 	for (int i = 0; i < ncomp; i++) {
 		DOF code = DOF::findByPosition(i);
-		auto codeIter = this->stiffness.componentByDofs.find(make_pair(code, code));
-		double value;
-		if (codeIter != this->stiffness.componentByDofs.end()) {
-			value = codeIter->second;
-		} else {
-			value = 0;
-		}
-		result.push_back(value);
+		result.push_back(this->stiffness.getComponent(code, code));
 	}
 	return result;
 }
@@ -325,26 +318,18 @@ bool DiscretePoint::hasRotations() const {
 
 double DiscretePoint::findStiffness(DOF rowdof, DOF coldof) const {
 	double result;
-	auto codeIter = stiffness.componentByDofs.find(make_pair(rowdof, coldof));
-	if (codeIter != stiffness.componentByDofs.end()) {
-		result = codeIter->second;
+	if (stiffness.hasComponent(rowdof, coldof)) {
+		result = stiffness.getComponent(rowdof, coldof);
+	} else if (symmetric) {
+		result = stiffness.getComponent(coldof, rowdof);
 	} else {
-		if (symmetric) {
-			codeIter = stiffness.componentByDofs.find(make_pair(coldof, rowdof));
-			if (codeIter != stiffness.componentByDofs.end()) {
-				result = codeIter->second;
-			} else {
-				result = 0.0;
-			}
-		} else {
-			result = 0.0;
-		}
+		result = 0.0;
 	}
 	return result;
 }
 
 void DiscretePoint::addStiffness(DOF rowdof, DOF coldof, double value) {
-	this->stiffness.componentByDofs[make_pair(rowdof, coldof)] = value;
+	this->stiffness.setComponent(rowdof, coldof, value);
 }
 
 DiscreteSegment::DiscreteSegment(Model& model, bool symmetric, int original_id) :
@@ -392,29 +377,19 @@ bool DiscreteSegment::hasRotations() const {
 
 double DiscreteSegment::findStiffness(int rowindex, int colindex, DOF rowdof, DOF coldof) const {
 	double result;
-	const DOFMatrix* matrix = &stiffness[rowindex][colindex];
-	auto codeIter = matrix->componentByDofs.find(make_pair(rowdof, coldof));
-	if (codeIter != matrix->componentByDofs.end()) {
-		result = codeIter->second;
+	const DOFMatrix& matrix = stiffness[rowindex][colindex];
+	if (matrix.hasComponent(rowdof, coldof)) {
+		result = matrix.getComponent(rowdof, coldof);
+	} else if (symmetric) {
+		result = stiffness[colindex][rowindex].getComponent(coldof, rowdof);
 	} else {
-		if (symmetric) {
-			matrix = &stiffness[colindex][rowindex];
-			codeIter = matrix->componentByDofs.find(make_pair(coldof, rowdof));
-			if (codeIter != matrix->componentByDofs.end()) {
-				result = codeIter->second;
-			} else {
-				result = 0.0;
-			}
-		} else {
-			result = 0.0;
-		}
+		result = 0.0;
 	}
 	return result;
 }
 
 void DiscreteSegment::addStiffness(int rowindex, int colindex, DOF rowdof, DOF coldof, double value) {
-	DOFMatrix* matrix = &stiffness[rowindex][colindex];
-	matrix->componentByDofs[make_pair(rowdof, coldof)] = value;
+	stiffness[rowindex][colindex].setComponent(rowdof, coldof, value);
 }
 
 vector<double> DiscreteSegment::asVector(bool addRotationsIfNotPresent) {
@@ -472,26 +447,22 @@ bool StructuralSegment::hasDamping() const {
 }
 
 void StructuralSegment::addStiffness(DOF rowdof, DOF coldof, double value){
-	stiffness.componentByDofs[make_pair(rowdof, coldof)] = value;
+	stiffness.setComponent(rowdof, coldof, value);
 }
 void StructuralSegment::addMass(DOF rowdof, DOF coldof, double value){
-	mass.componentByDofs[make_pair(rowdof, coldof)] = value;
+	mass.setComponent(rowdof, coldof, value);
 }
 void StructuralSegment::addDamping(DOF rowdof, DOF coldof, double value){
-	damping.componentByDofs[make_pair(rowdof, coldof)] = value;
+	damping.setComponent(rowdof, coldof, value);
 }
 
 double StructuralSegment::findStiffness(DOF rowdof, DOF coldof) const{
 	double result=0.0;
-	auto itFind = stiffness.componentByDofs.find(make_pair(rowdof, coldof));
-	if (itFind != stiffness.componentByDofs.end()) {
-		result = itFind->second;
+	if (stiffness.hasComponent(rowdof, coldof)) {
+		result = stiffness.getComponent(rowdof, coldof);
 	}else{
 		if (symmetric){
-			itFind = stiffness.componentByDofs.find(make_pair(coldof, rowdof));
-			if (itFind != stiffness.componentByDofs.end()) {
-				result = itFind->second;
-			}
+			result = stiffness.getComponent(coldof, rowdof);
 		}
 	}
 	return result;
@@ -625,29 +596,27 @@ void MatrixElement::addComponent(const int nodeid1, const DOF dof1, const int no
 		myDof2 = dof1;
 	}
 	auto it = submatrixByNodes.find(make_pair(nodePosition1, nodePosition2));
-	shared_ptr<DOFMatrix> subMatrix = nullptr;
-	if (it != submatrixByNodes.end()) {
-		subMatrix = it->second;
-	} else {
-		subMatrix = make_shared<DOFMatrix>(DOFMatrix(symmetric && nodeid1 == nodeid2));
-		this->submatrixByNodes[make_pair(nodePosition1, nodePosition2)] = subMatrix;
+	if (it == submatrixByNodes.end()) {
+		it = submatrixByNodes.emplace(make_pair(nodePosition1, nodePosition2),
+				DOFMatrix(symmetric && nodeid1 == nodeid2)).first;
 	}
-    subMatrix->addComponent(myDof1, myDof2, value);
+	it->second.addComponent(myDof1, myDof2, value);
+	dofsByNodePosition.clear();
 }
 
 void MatrixElement::clear() {
     submatrixByNodes.clear();
+    dofsByNodePosition.clear();
 }
 
 
-const shared_ptr<DOFMatrix> MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
-	shared_ptr<DOFMatrix> result = make_shared<DOFMatrix>(DOFMatrix(symmetric));
+const DOFMatrix& MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
+	static const DOFMatrix emptySubmatrix;
 	auto it = submatrixByNodes.find(make_pair(nodePosition1, nodePosition2));
 	if (it != submatrixByNodes.end()) {
-		std::copy(it->second->componentByDofs.begin(), it->second->componentByDofs.end(),
-				std::inserter(result->componentByDofs, result->componentByDofs.end()));
+		return it->second;
 	}
-	return result;
+	return emptySubmatrix;
 }
 
 const set<int> MatrixElement::nodePositions() const {
@@ -660,18 +629,21 @@ const set<int> MatrixElement::nodePositions() const {
 }
 
 const DOFS MatrixElement::getDOFSForNode(int nodePosition) const {
-	DOFS dofs;
-	for (auto& kv : submatrixByNodes) {
-		if (kv.first.first == nodePosition or kv.first.second) {
-			if (kv.second->hasRotations()) {
+	if (dofsByNodePosition.empty()) {
+		for (auto& kv : submatrixByNodes) {
+			DOFS dofs;
+			if (kv.second.hasRotations()) {
 				dofs += DOFS::ROTATIONS;
 			}
-			if (kv.second->hasTranslations()) {
+			if (kv.second.hasTranslations()) {
 				dofs += DOFS::TRANSLATIONS;
 			}
+			dofsByNodePosition[kv.first.first] += dofs;
+			dofsByNodePosition[kv.first.second] += dofs;
 		}
 	}
-	return dofs;
+	auto it = dofsByNodePosition.find(nodePosition);
+	return it == dofsByNodePosition.end() ? DOFS() : it->second;
 }
 
 const set<pair<int, int>> MatrixElement::nodePairs() const {
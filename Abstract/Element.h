@@ -379,8 +379,15 @@ class NodalMass: public ElementSet {
 /* Matrix for a group nodes.*/
 class MatrixElement : public ElementSet {
 private:
-	std::map<std::pair<int, int>, shared_ptr<DOFMatrix>> submatrixByNodes;
+	/**
+	 * Submatrices by pair of node positions, the lower position first.
+	 */
+	std::unordered_map<std::pair<int, int>, DOFMatrix, boost::hash<std::pair<int, int>>> submatrixByNodes;
 	bool symmetric = false;
+	/**
+	 * DOFS used by the submatrices around each node, built on the first call to getDOFSForNode().
+	 */
+	mutable std::unordered_map<int, DOFS> dofsByNodePosition;
 public:
 	MatrixElement(Model&, Type type, bool symmetric = false, int original_id = NO_ORIGINAL_ID);
 	void addComponent(const int nodeid1, const DOF dof1, const int nodeid2, const DOF dof2, const double value);
@@ -388,7 +395,10 @@ public:
 	 * Clear all nodes and submatrices of the Matrix.
 	 */
 	void clear();
-	const shared_ptr<DOFMatrix> findSubmatrix(const int nodePosition1, const int nodePosition2) const;
+	/**
+	 * Submatrix between the two nodes, as stored (an empty matrix if there is none).
+	 */
+	const DOFMatrix& findSubmatrix(const int nodePosition1, const int nodePosition2) const;
 	const std::set<int> nodePositions() const override;
 	const std::set<std::pair<int, int>> nodePairs() const;
 	const std::set<std::pair<int, int>> findInPairs(int nodePosition) const;
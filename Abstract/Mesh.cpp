@@ -9,6 +9,7 @@
  */
 
 #include "Mesh.h"
+#include "Model.h"
 
 #if defined VDEBUG && defined __GNUC__
 #include <valgrind/memcheck.h>
@@ -41,12 +42,70 @@ namespace fs = boost::filesystem;
 
 const double NodeStorage::RESERVED_POSITION = -DBL_MAX;
 
+const size_t Mesh::MED_WRITE_BLOCK_SIZE = 1 << 16;
+
+const int PositionIndex::UNAVAILABLE_POSITION;
+
+bool PositionIndex::fitsInDenseRange(int id) {
+	if (densePositions.empty()) {
+		firstDenseId = id;
+		densePositions.assign(1, UNAVAILABLE_POSITION);
+		return true;
+	}
+	const long long first = firstDenseId;
+	const long long last = first + static_cast<long long>(densePositions.size()) - 1;
+	if (id >= first && id <= last) {
+		return true;
+	}
+	// Grow the flat array only while it stays reasonably filled, otherwise
+	// the id is kept in the hash table.
+	const long long maxRange = 2 * static_cast<long long>(count) + 4096;
+	if (id > last) {
+		if (id - first + 1 > maxRange) {
+			return false;
+		}
+		densePositions.resize(static_cast<size_t>(id - first + 1), UNAVAILABLE_POSITION);
+		return true;
+	}
+	if (last - id + 1 > maxRange) {
+		return false;
+	}
+	// Leave some headroom below the new first id to amortize further shifts
+	const long long headroom = min(static_cast<long long>(densePositions.size()),
+			min(maxRange - (last - id + 1), id - static_cast<long long>(INT_MIN)));
+	const long long newFirst = id - headroom;
+	densePositions.insert(densePositions.begin(), static_cast<size_t>(first - newFirst),
+			UNAVAILABLE_POSITION);
+	firstDenseId = static_cast<int>(newFirst);
+	return true;
+}
+
+void PositionIndex::set(int id, int position) {
+	if (fitsInDenseRange(id)) {
+		int& densePosition = densePositions[static_cast<size_t>(static_cast<long long>(id) - firstDenseId)];
+		if (densePosition == UNAVAILABLE_POSITION) {
+			// The id may have been stored in the hash table before the flat array reached it
+			if (sparsePositions.erase(id) == 0) {
+				count++;
+			}
+		}
+		densePosition = position;
+		return;
+	}
+	if (sparsePositions.insert(make_pair(id, position)).second) {
+		count++;
+	} else {
+		sparsePositions[id] = position;
+	}
+}
+
 /**
  * Node Container class
  */
 NodeStorage::NodeStorage(Mesh* mesh, LogLevel logLevel) :
 		logLevel(logLevel), mesh(mesh) {
 	nodeDatas.reserve(4096);
+	coordinates.reserve(3 * 4096);
 }
 
 NodeIterator NodeStorage::begin() const {
@@ -60,7 +119,7 @@ NodeIterator NodeStorage::end() const {
 int NodeStorage::reserveNodePosition(int nodeId) {
 	int nodePosition = mesh->addNode(nodeId, RESERVED_POSITION, RESERVED_POSITION,
 			RESERVED_POSITION);
-	nodepositionById[nodeId] = nodePosition;
+	nodepositionById.set(nodeId, nodePosition);
 	if (this->logLevel >= LogLevel::TRACE) {
 		cout << "Reserve node id:" << nodeId << " position:" << nodePosition << endl;
 	}
@@ -74,6 +133,7 @@ CellData::CellData(int id, CellType type, bool isvirtual, int elementId, int cel
 
 int Mesh::addNode(int id, double x, double y, double z, int cpPos, int cdPos) {
 	int nodePosition;
+	invalidateGlobalCoordinates();
 
 	// In auto mode, we assign the first free node, starting from the biggest possible number
 	if (id == Node::AUTO_ID){
@@ -82,26 +142,26 @@ int Mesh::addNode(int id, double x, double y, double z, int cpPos, int cdPos) {
 			id = Node::auto_node_id--;
 		}
 	}
-	auto positionIterator = nodes.nodepositionById.find(id);
-	if (positionIterator == nodes.nodepositionById.end()) {
+	nodePosition = nodes.nodepositionById.find(id);
+	if (nodePosition == PositionIndex::UNAVAILABLE_POSITION) {
 		nodePosition = static_cast<int>(nodes.nodeDatas.size());
 		NodeData nodeData;
 
 		nodeData.id = id;
-		nodeData.x = x;
-		nodeData.y = y;
-		nodeData.z = z;
 		nodeData.dofs = DOFS::NO_DOFS;
 		nodeData.cpPos = cpPos;
 		nodeData.cdPos = cdPos;
 		nodes.nodeDatas.push_back(nodeData);
-		nodes.nodepositionById[id] = nodePosition;
+		nodes.coordinates.push_back(x);
+		nodes.coordinates.push_back(y);
+		nodes.coordinates.push_back(z);
+		nodes.nodepositionById.set(id, nodePosition);
 	} else {
-		nodePosition = positionIterator->second;
 		NodeData& nodeData = nodes.nodeDatas[nodePosition];
-		nodeData.x = x;
-		nodeData.y = y;
-		nodeData.z = z;
+		double* coordinates = &nodes.coordinates[3 * static_cast<size_t>(nodePosition)];
+		coordinates[0] = x;
+		coordinates[1] = y;
+		coordinates[2] = z;
         nodeData.cpPos = cpPos;
         nodeData.cdPos = cdPos;
 	}
@@ -119,12 +179,19 @@ const Node Mesh::findNode(const int nodePosition, const bool buildGlobalXYZ, con
 				string("Node position ") + lexical_cast<string>(nodePosition) + " not found.");
 	}
 	const NodeData &nodeData = nodes.nodeDatas[nodePosition];
-	Node node1 = Node(nodeData.id, nodeData.x, nodeData.y, nodeData.z, nodePosition, nodeData.dofs,
+	const double* coordinates = &nodes.coordinates[3 * static_cast<size_t>(nodePosition)];
+	Node node1 = Node(nodeData.id, coordinates[0], coordinates[1], coordinates[2], nodePosition, nodeData.dofs,
 			nodeData.cpPos, nodeData.cdPos);
 
 	// If asked, we compute the position of the Node in the Global Referentiel System
 	if (buildGlobalXYZ){
-	    node1.buildGlobalXYZ(model);
+		if (model != nullptr && globalCoordinatesModel == model) {
+			node1.x = globalX[nodePosition];
+			node1.y = globalY[nodePosition];
+			node1.z = globalZ[nodePosition];
+		} else {
+			node1.buildGlobalXYZ(model);
+		}
 	}
 	/*
 	 * #if defined VDEBUG && defined __GNUC__
@@ -136,6 +203,84 @@ const Node Mesh::findNode(const int nodePosition, const bool buildGlobalXYZ, con
 	return node1;
 }
 
+void Mesh::buildGlobalCoordinates(const Model& model) const {
+	if (globalCoordinatesModel == &model) {
+		return;
+	}
+	const size_t nodeCount = nodes.nodeDatas.size();
+	globalX.resize(nodeCount);
+	globalY.resize(nodeCount);
+	globalZ.resize(nodeCount);
+	// nodes in the global coordinate system are copied, the others are gathered by system
+	map<int, vector<int>> nodePositionsByCS;
+	const double* coordinates = nodes.coordinates.data();
+	for (size_t i = 0; i < nodeCount; i++) {
+		const int cpPos = nodes.nodeDatas[i].cpPos;
+		if (cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+			globalX[i] = coordinates[3 * i];
+			globalY[i] = coordinates[3 * i + 1];
+			globalZ[i] = coordinates[3 * i + 2];
+		} else {
+			nodePositionsByCS[cpPos].push_back(static_cast<int>(i));
+		}
+	}
+	vector<double> lx, ly, lz, x, y, z;
+	for (const auto& csAndNodePositions : nodePositionsByCS) {
+		const vector<int>& nodePositions = csAndNodePositions.second;
+		const size_t count = nodePositions.size();
+		lx.resize(count);
+		ly.resize(count);
+		lz.resize(count);
+		for (size_t i = 0; i < count; i++) {
+			const double* local = coordinates + 3 * static_cast<size_t>(nodePositions[i]);
+			lx[i] = local[0];
+			ly[i] = local[1];
+			lz[i] = local[2];
+		}
+		shared_ptr<CoordinateSystem> coordSystem = model.getCoordinateSystemByPosition(
+				csAndNodePositions.first);
+		if (coordSystem) {
+			x.resize(count);
+			y.resize(count);
+			z.resize(count);
+			coordSystem->positionsToGlobal(count, lx.data(), ly.data(), lz.data(), x.data(),
+					y.data(), z.data());
+		} else {
+			// Same fallback as Node::buildGlobalXYZ, reported once for the whole system
+			cerr << "ERROR: Coordinate System of position " << csAndNodePositions.first
+					<< " for " << count << " nodes not found."
+					<< " Global Coordinate System used instead." << endl;
+			x.swap(lx);
+			y.swap(ly);
+			z.swap(lz);
+		}
+		for (size_t i = 0; i < count; i++) {
+			globalX[nodePositions[i]] = x[i];
+			globalY[nodePositions[i]] = y[i];
+			globalZ[nodePositions[i]] = z[i];
+		}
+	}
+	globalCoordinatesModel = &model;
+}
+
+const vector<double>& Mesh::getGlobalCoordinates(const Model& model, int axis) const {
+	buildGlobalCoordinates(model);
+	switch (axis) {
+	case 0:
+		return globalX;
+	case 1:
+		return globalY;
+	case 2:
+		return globalZ;
+	default:
+		throw invalid_argument("Axis " + to_string(axis) + " is not 0 (X), 1 (Y) or 2 (Z).");
+	}
+}
+
+void Mesh::invalidateGlobalCoordinates() const {
+	globalCoordinatesModel = nullptr;
+}
+
 int Mesh::findOrReserveNode(int nodeId) {
 
 	int nodePosition = findNodePosition(nodeId);
@@ -153,11 +298,11 @@ set<int> Mesh::findOrReserveNodes(const set<int>& nodeIds) {
 }
 
 int Mesh::findNodePosition(const int nodeId) const {
-	auto positionIterator = this->nodes.nodepositionById.find(nodeId);
-	if (positionIterator == this->nodes.nodepositionById.end()) {
+	const int position = this->nodes.nodepositionById.find(nodeId);
+	if (position == PositionIndex::UNAVAILABLE_POSITION) {
 		return Node::UNAVAILABLE_NODE;
 	}
-	return positionIterator->second;
+	return position;
 }
 
 void Mesh::allowDOFS(int nodePosition, const DOFS allowed) {
@@ -230,7 +375,7 @@ int Mesh::addCell(int id, const CellType &cellType, const std::vector<int> &node
 					string("Duplicate node in connectivity cellId:")
 							+ lexical_cast<string>(cellId));
 		}
-		if (cells.cellpositionById.find(cellId) != cells.cellpositionById.end()) {
+		if (cells.cellpositionById.find(cellId) != PositionIndex::UNAVAILABLE_POSITION) {
 			throw logic_error(
 					string("CellId: ") + lexical_cast<string>(cellId) + " Already used.");
 		}
@@ -241,19 +386,17 @@ int Mesh::addCell(int id, const CellType &cellType, const std::vector<int> &node
 		throw logic_error("Invalid cell");
 	}
 
-	cells.cellpositionById[cellId] = cellPosition;
+	cells.cellpositionById.set(cellId, cellPosition);
 	const int cellTypePosition = static_cast<int>(cellPositionsByType.find(cellType)->second.size());
 	cellPositionsByType.find(cellType)->second.push_back(cellPosition);
 	CellData cellData(cellId, cellType, virtualCell, elementId, cellTypePosition);
 
-	if (cells.nodepositionsByCelltype.find(cellType) == cells.nodepositionsByCelltype.end()) {
-		cells.nodepositionsByCelltype[cellType] = make_shared<deque<int>>(deque<int>());
-	}
-	shared_ptr<deque<int>> nodePositionsPtr = cells.nodepositionsByCelltype[cellType];
+	CellConnectivity& connectivity = cells.findOrCreateConnectivity(cellType);
 	for (unsigned int i = 0; i < nodeIds.size(); i++) {
 		int nodePosition = findOrReserveNode(nodeIds[i]);
-		nodePositionsPtr->push_back(nodePosition);
+		connectivity.pushNodePosition(nodePosition);
 	}
+	connectivity.endCell();
 	if (cpos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
 		CellGroup* coordinateSystemCellGroup = this->getOrCreateCellGroupForOrientation(cpos);
 		coordinateSystemCellGroup->addCell(cellId);
@@ -300,20 +443,18 @@ int Mesh::updateCell(int id, const CellType &cellType, const std::vector<int> &n
     // We build another CellData, with an other cellPosition, and hope
     // for the best
     const int cellPosition = static_cast<int>(cells.cellDatas.size());
-    cells.cellpositionById[id] = cellPosition;
+    cells.cellpositionById.set(id, cellPosition);
 
     const int cellTypePosition = static_cast<int>(cellPositionsByType.find(cellType)->second.size());
     cellPositionsByType.find(cellType)->second.push_back(cellPosition);
     CellData cellData(id, cellType, virtualCell, elementId, cellTypePosition);
 
-    if (cells.nodepositionsByCelltype.find(cellType) == cells.nodepositionsByCelltype.end()) {
-        cells.nodepositionsByCelltype[cellType] = make_shared<deque<int>>(deque<int>());
-    }
-    shared_ptr<deque<int>> nodePositionsPtr = cells.nodepositionsByCelltype[cellType];
+    CellConnectivity& connectivity = cells.findOrCreateConnectivity(cellType);
     for (unsigned int i = 0; i < nodeIds.size(); i++) {
         int nodePosition = findOrReserveNode(nodeIds[i]);
-        nodePositionsPtr->push_back(nodePosition);
+        connectivity.pushNodePosition(nodePosition);
     }
+    connectivity.endCell();
     if (cpos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
         CellGroup* coordinateSystemCellGroup = this->getOrCreateCellGroupForOrientation(cpos);
         coordinateSystemCellGroup->addCell(id);
@@ -331,15 +472,12 @@ const Cell Mesh::findCell(int cellPosition) const {
 	}
 	const CellData& cellData = cells.cellDatas[cellPosition];
 	const CellType* type = CellType::findByCode(cellData.typeCode);
-	const unsigned int numNodes = type->numNodes;
-	vector<int> nodeIds;
-	nodeIds.resize(numNodes);
-	auto it = cells.nodepositionsByCelltype.find(*type);
-	deque<int>& globalNodePositions = *(it->second);
-	const int start = cellData.cellTypePosition * numNodes;
-	vector<int> nodePositions(globalNodePositions.begin() + start,
-			globalNodePositions.begin() + start + numNodes);
-	for (unsigned int i = 0; i < numNodes; i++) {
+	const CellConnectivity& connectivity = cells.connectivityByCelltype.find(*type)->second;
+	const size_t numNodes = connectivity.size(cellData.cellTypePosition);
+	const int* cellNodePositions = connectivity.cellNodePositions(cellData.cellTypePosition);
+	vector<int> nodePositions(cellNodePositions, cellNodePositions + numNodes);
+	vector<int> nodeIds(numNodes);
+	for (size_t i = 0; i < numNodes; i++) {
 		const NodeData &nodeData = nodes.nodeDatas[nodePositions[i]];
 		nodeIds[i] = nodeData.id;
 	}
@@ -347,6 +485,82 @@ const Cell Mesh::findCell(int cellPosition) const {
 	return cell;
 }
 
+const CellView Mesh::findCellView(int cellPosition) const {
+	if (cellPosition == Cell::UNAVAILABLE_CELL) {
+		throw logic_error("Unavailable cell requested.");
+	}
+	const CellData& cellData = cells.cellDatas[cellPosition];
+	const CellType* type = CellType::findByCode(cellData.typeCode);
+	const CellConnectivity& connectivity = cells.connectivityByCelltype.find(*type)->second;
+	return CellView(&nodes, &cellData, type,
+			connectivity.cellNodePositions(cellData.cellTypePosition),
+			connectivity.size(cellData.cellTypePosition));
+}
+
+bool Mesh::isCurrentCellPosition(int cellPosition) const {
+	// updateCell leaves the previous CellData behind, under the same id
+	return cells.cellpositionById.find(cells.cellDatas[cellPosition].id) == cellPosition;
+}
+
+void Mesh::buildNodeAdjacency() const {
+	const size_t cellCount = cells.cellDatas.size();
+	adjacencyOffsets.assign(nodes.nodeDatas.size() + 1, 0);
+	for (size_t cellPosition = 0; cellPosition < cellCount; cellPosition++) {
+		for (int nodePosition : findCellView(static_cast<int>(cellPosition)).nodePositions()) {
+			adjacencyOffsets[static_cast<size_t>(nodePosition) + 1]++;
+		}
+	}
+	for (size_t i = 1; i < adjacencyOffsets.size(); i++) {
+		adjacencyOffsets[i] += adjacencyOffsets[i - 1];
+	}
+	adjacentCellPositions.resize(static_cast<size_t>(adjacencyOffsets.back()));
+	vector<int> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (size_t cellPosition = 0; cellPosition < cellCount; cellPosition++) {
+		for (int nodePosition : findCellView(static_cast<int>(cellPosition)).nodePositions()) {
+			adjacentCellPositions[static_cast<size_t>(cursors[static_cast<size_t>(nodePosition)]++)] =
+					static_cast<int>(cellPosition);
+		}
+	}
+	adjacencyCellCount = cellCount;
+}
+
+vector<int> Mesh::findCellPositionsOfNode(int nodePosition) const {
+	const size_t cellCount = cells.cellDatas.size();
+	// Rebuild when the cells added since the last build become too many to be scanned
+	if (cellCount - adjacencyCellCount > adjacencyCellCount / 8 + 1024) {
+		buildNodeAdjacency();
+	}
+	vector<int> result;
+	const size_t node = static_cast<size_t>(nodePosition);
+	if (node + 1 < adjacencyOffsets.size()) {
+		for (int i = adjacencyOffsets[node]; i < adjacencyOffsets[node + 1]; i++) {
+			const int cellPosition = adjacentCellPositions[static_cast<size_t>(i)];
+			// a node repeated in a connectivity gives consecutive duplicates
+			if ((result.empty() || result.back() != cellPosition) && isCurrentCellPosition(cellPosition)) {
+				result.push_back(cellPosition);
+			}
+		}
+	}
+	for (size_t cellPosition = adjacencyCellCount; cellPosition < cellCount; cellPosition++) {
+		const int position = static_cast<int>(cellPosition);
+		const auto nodePositions = findCellView(position).nodePositions();
+		if (find(nodePositions.begin(), nodePositions.end(), nodePosition) != nodePositions.end()
+				&& isCurrentCellPosition(position)) {
+			result.push_back(position);
+		}
+	}
+	return result;
+}
+
+void Mesh::createMEDBlockFilter(med_idt fid, med_int nentity, med_int nconstituent, size_t first,
+		size_t count, med_filter& filter) {
+	// one block of count entities, starting at entity first + 1 (MED numbering starts at 1)
+	if (MEDfilterBlockOfEntityCr(fid, nentity, 1, nconstituent, MED_ALL_CONSTITUENT,
+			MED_FULL_INTERLACE, MED_COMPACT_STMODE, MED_NO_PROFILE, static_cast<med_size>(first + 1),
+			static_cast<med_size>(count), 1, static_cast<med_size>(count), 0, &filter) < 0) {
+		throw logic_error("ERROR : creating MED filter ...");
+	}
+}
 
 void Mesh::createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
 		vector<Family>& families) {
@@ -369,6 +583,7 @@ void Mesh::writeMED(const char* medFileName) {
 	if (!finished) {
 		this->finish();
 	}
+	sortNodeGroups();
 	const char meshname[MED_NAME_SIZE + 1] = "3D unstructured mesh";
 	const med_int spacedim = 3;
 	const med_int meshdim = 3;
@@ -394,15 +609,12 @@ void Mesh::writeMED(const char* medFileName) {
 			MED_SORT_DTIT, MED_CARTESIAN, axisname, unitname) < 0) {
 		throw logic_error("ERROR : Mesh creation ...");
 	}
-	vector<med_float> coordinates;
-	coordinates.reserve(nnodes);
-	for (NodeData& nodeData : nodes.nodeDatas) {
-		coordinates.push_back(nodeData.x);
-		coordinates.push_back(nodeData.y);
-		coordinates.push_back(nodeData.z);
-	}
+	// Coordinates are stored interleaved, as MED expects them: they are written as is.
+	// Connectivities are written by blocks of at most MED_WRITE_BLOCK_SIZE cells, so that
+	// the temporary buffers stay small whatever the size of the mesh.
+	static_assert(sizeof(med_float) == sizeof(double), "MED floats are not doubles");
 	if (MEDmeshNodeCoordinateWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, MED_FULL_INTERLACE,
-			nnodes, coordinates.data()) < 0) {
+			nnodes, nodes.coordinates.data()) < 0) {
 		throw logic_error("ERROR : writing nodes ...");
 	}
 
@@ -416,28 +628,39 @@ void Mesh::writeMED(const char* medFileName) {
 	 nodes.countNodes(), nodeNames);
 	 delete[](nodeNames);*/
 
-	for (auto kv : cellPositionsByType) {
-		CellType type = kv.first;
-		vector<int> cellPositions = kv.second;
-		size_t numCells = cellPositions.size();
+	vector<med_int> connectivity;
+	for (const auto& kv : cellPositionsByType) {
+		const CellType& type = kv.first;
+		const size_t numCells = kv.second.size();
 		if (type.numNodes == 0 || numCells == 0) {
 			continue;
 		}
-		vector<med_int> connectivity;
-		connectivity.reserve(numCells * type.numNodes);
-		for (int cellPosition : cellPositions) {
-			const Cell cell = findCell(cellPosition);
-			for (int nodePosition : cell.nodePositions) {
+		// cells of a type are stored in cellTypePosition order, which is also the MED order
+		const vector<int>& nodePositions = cells.connectivityByCelltype.find(type)->second.allNodePositions();
+		for (size_t first = 0; first < numCells; first += MED_WRITE_BLOCK_SIZE) {
+			const size_t count = min(MED_WRITE_BLOCK_SIZE, numCells - first);
+			connectivity.clear();
+			connectivity.reserve(count * type.numNodes);
+			for (size_t i = first * type.numNodes; i < (first + count) * type.numNodes; i++) {
 				// med nodes starts at node number 1.
-				connectivity.push_back(static_cast<med_int>(nodePosition + 1));
+				connectivity.push_back(static_cast<med_int>(nodePositions[i] + 1));
+			}
+			med_err result;
+			if (count == numCells) {
+				result = MEDmeshElementConnectivityWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0,
+						MED_CELL, type.code, MED_NODAL, MED_FULL_INTERLACE,
+						static_cast<med_int>(numCells), connectivity.data());
+			} else {
+				med_filter filter = MED_FILTER_INIT;
+				createMEDBlockFilter(fid, static_cast<med_int>(numCells),
+						static_cast<med_int>(type.numNodes), first, count, filter);
+				result = MEDmeshElementConnectivityAdvancedWr(fid, meshname, MED_NO_DT, MED_NO_IT,
+						0.0, MED_CELL, type.code, MED_NODAL, &filter, connectivity.data());
+				MEDfilterClose(&filter);
+			}
+			if (result < 0) {
+				throw logic_error("ERROR : writing cells ...");
 			}
-		}
-		int result = MEDmeshElementConnectivityWr(fid, meshname, MED_NO_DT,
-		MED_NO_IT, 0.0, MED_CELL, type.code, MED_NODAL, MED_FULL_INTERLACE,
-				static_cast<med_int>(numCells),
-				connectivity.data());
-		if (result < 0) {
-			throw logic_error("ERROR : writing cells ...");
 		}
 
 		/*		 char* cellNames = new char[numCells*MED_SNAME_SIZE+1]();
@@ -538,6 +761,32 @@ CellStorage::CellStorage(Mesh* mesh, LogLevel logLevel) :
 		logLevel(logLevel), mesh(mesh) {
 }
 
+CellConnectivity& CellStorage::findOrCreateConnectivity(const CellType& cellType) {
+	auto it = connectivityByCelltype.find(cellType);
+	if (it == connectivityByCelltype.end()) {
+		it = connectivityByCelltype.insert(make_pair(cellType, CellConnectivity(cellType))).first;
+	}
+	return it->second;
+}
+
+const CellConnectivity* CellStorage::connectivity(const CellType& cellType) const {
+	auto it = connectivityByCelltype.find(cellType);
+	return it == connectivityByCelltype.end() ? nullptr : &it->second;
+}
+
+CellConnectivity::CellConnectivity(const CellType& cellType) :
+		numNodes(cellType.specificSize ? cellType.numNodes : 0) {
+	if (numNodes == 0) {
+		offsets.push_back(0);
+	}
+}
+
+void CellConnectivity::endCell() {
+	if (numNodes == 0) {
+		offsets.push_back(nodePositions.size());
+	}
+}
+
 CellIterator CellStorage::cells_begin(const CellType &type) const {
 	if (type.numNodes == 0) {
 		throw logic_error(
@@ -560,10 +809,17 @@ int Mesh::countCells() const {
 }
 
 void Mesh::finish() {
+	sortNodeGroups();
 	finished = true;
 
 }
 
+void Mesh::sortNodeGroups() {
+	for (NodeGroup* nodeGroup : getNodeGroups()) {
+		nodeGroup->sortNodePositions();
+	}
+}
+
 NodeGroup* Mesh::createNodeGroup(const string& name, int group_id, const string & comment) {
 	if (name.empty()) {
 		throw invalid_argument("Can't create a nodeGroup with empty name ");
@@ -725,17 +981,15 @@ int Mesh::countCells(const CellType& type) const {
 }
 
 bool Mesh::hasCell(int cellId) const {
-	auto positionIterator =
-			cells.cellpositionById.find(cellId);
-	return positionIterator != cells.cellpositionById.end();
+	return cells.cellpositionById.find(cellId) != PositionIndex::UNAVAILABLE_POSITION;
 }
 
 int Mesh::findCellPosition(int cellId) const {
-	auto it = this->cells.cellpositionById.find(cellId);
-	if (it == this->cells.cellpositionById.end()) {
+	const int position = this->cells.cellpositionById.find(cellId);
+	if (position == PositionIndex::UNAVAILABLE_POSITION) {
 		return Cell::UNAVAILABLE_CELL;
 	}
-	return it->second;
+	return position;
 }
 
 bool Mesh::validate() const {
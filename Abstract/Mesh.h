@@ -29,14 +29,56 @@
 namespace vega {
 
 class Mesh;
+class CellView;
 
+/**
+ * Maps input model ids (node or cell numbers) to Vega positions.
+ * Ids are usually compact, so they are stored in a flat array indexed by
+ * (id - firstDenseId) ; ids falling far away from this range (auto generated
+ * ids, very sparse numbering) go to a hash table instead.
+ **/
+class PositionIndex final {
+private:
+	std::vector<int> densePositions;
+	int firstDenseId = 0;
+	std::unordered_map<int, int> sparsePositions;
+	size_t count = 0;
+	bool fitsInDenseRange(int id);
+public:
+	static const int UNAVAILABLE_POSITION = INT_MIN;
+	/**
+	 * Returns the position associated to id, or UNAVAILABLE_POSITION.
+	 **/
+	inline int find(int id) const {
+		const long long offset = static_cast<long long>(id) - firstDenseId;
+		if (offset >= 0 && offset < static_cast<long long>(densePositions.size())) {
+			const int position = densePositions[static_cast<size_t>(offset)];
+			if (position != UNAVAILABLE_POSITION) {
+				return position;
+			}
+		}
+		if (sparsePositions.empty()) {
+			return UNAVAILABLE_POSITION;
+		}
+		auto it = sparsePositions.find(id);
+		return it == sparsePositions.end() ? UNAVAILABLE_POSITION : it->second;
+	}
+	/**
+	 * Associates position to id, overwriting any previous position.
+	 **/
+	void set(int id, int position);
+	size_t size() const {
+		return count;
+	}
+};
+
+/**
+ * Everything about a node but its coordinates, which are in NodeStorage::coordinates.
+ **/
 class NodeData final {
 public:
 	int id;
 	char dofs;
-	double x;
-	double y;
-	double z;
 	int cpPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID; /**< Vega Position Number of the CS used for location (x,y,z) **/;
 	int cdPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID; /**< Vega Position Number of the CS used for displacements, forces, constraints **/;
 };
@@ -45,10 +87,17 @@ class NodeStorage final {
 private:
 	friend Mesh;
 	friend NodeGroup;
+	friend CellView;
 
 	const LogLevel logLevel;
 	std::vector<NodeData> nodeDatas;
-	std::map<int, int> nodepositionById;
+	/**
+	 * Coordinates of the nodes in their location Coordinate System (cpPos), interleaved:
+	 * x, y, z of the node at position p are at 3 * p, 3 * p + 1 and 3 * p + 2.
+	 * Kept apart from nodeDatas, so that coordinate passes only read coordinates.
+	 **/
+	std::vector<double> coordinates;
+	PositionIndex nodepositionById;
 	/**
 	 * Reserve a node position (VEGA Id) given a node id (input model id).
 	 * WARNING! Reserving an already created node will erase the previous value
@@ -60,6 +109,18 @@ public:
 	Mesh* mesh;
 
 	NodeStorage(Mesh* mesh, LogLevel logLevel);
+	/**
+	 * Interleaved local coordinates of all the nodes, in the layout MED_FULL_INTERLACE.
+	 **/
+	const std::vector<double>& getCoordinates() const {
+		return coordinates;
+	}
+	/**
+	 * Ids and coordinate systems of all the nodes, by position.
+	 **/
+	const std::vector<NodeData>& getNodeDatas() const {
+		return nodeDatas;
+	}
 	NodeIterator begin() const;
 	NodeIterator end() const;
 
@@ -77,6 +138,53 @@ public:
 	int cellTypePosition;
 };
 
+/**
+ * Node positions of all the cells of one CellType, stored contiguously in
+ * cellTypePosition order. Types with a fixed number of nodes are addressed by
+ * cellTypePosition * numNodes, variable size types (POLY*) also keep the
+ * offset of the first node of each cell (CSR layout).
+ **/
+class CellConnectivity final {
+private:
+	const unsigned int numNodes; /**< 0 when the number of nodes varies from cell to cell */
+	std::vector<int> nodePositions;
+	std::vector<size_t> offsets; /**< cellCount + 1 offsets, only for variable size types */
+public:
+	explicit CellConnectivity(const CellType& cellType);
+	/**
+	 * Append a node to the cell currently being added, call endCell() after its last node.
+	 **/
+	inline void pushNodePosition(int nodePosition) {
+		nodePositions.push_back(nodePosition);
+	}
+	void endCell();
+	inline size_t begin(int cellTypePosition) const {
+		return numNodes > 0 ? static_cast<size_t>(cellTypePosition) * numNodes : offsets[static_cast<size_t>(cellTypePosition)];
+	}
+	inline size_t size(int cellTypePosition) const {
+		return numNodes > 0 ? numNodes : offsets[static_cast<size_t>(cellTypePosition) + 1] - offsets[static_cast<size_t>(cellTypePosition)];
+	}
+	/**
+	 * Node positions of the cell at cellTypePosition, size(cellTypePosition) values.
+	 **/
+	inline const int* cellNodePositions(int cellTypePosition) const {
+		return nodePositions.data() + begin(cellTypePosition);
+	}
+	/**
+	 * Node positions of all the cells of this type, one after the other.
+	 **/
+	const std::vector<int>& allNodePositions() const {
+		return nodePositions;
+	}
+	/**
+	 * Offsets of each cell in allNodePositions() followed by the total size.
+	 * Empty for fixed size types.
+	 **/
+	const std::vector<size_t>& cellOffsets() const {
+		return offsets;
+	}
+};
+
 class CellStorage final {
 private:
 	friend Mesh;
@@ -85,21 +193,83 @@ private:
 
 	const LogLevel logLevel;
 	std::vector<CellData> cellDatas;
-	std::map<int, int> cellpositionById;
-	std::map<CellType, std::shared_ptr<std::deque<int>>> nodepositionsByCelltype;
+	PositionIndex cellpositionById;
+	std::unordered_map<CellType, CellConnectivity, std::hash<CellType>> connectivityByCelltype;
 	/*
 	 * Reserve a cell position given an id
 	 */
 	int reserveCellPosition(int nodeId);
+	CellConnectivity& findOrCreateConnectivity(const CellType& cellType);
 public:
 	Mesh* mesh;
 	CellStorage(Mesh* mesh, LogLevel logLevel);
+	/**
+	 * Connectivity of all the cells of a given type, or nullptr if there is none.
+	 **/
+	const CellConnectivity* connectivity(const CellType& cellType) const;
 	CellIterator cells_begin(const CellType &type) const;
 	CellIterator cells_end(const CellType &type) const;
 
 	bool validate() const;
 };
 
+/**
+ * Read-only view on a cell stored in the Mesh, see Mesh::findCellView.
+ * Contrary to Cell it does not copy the connectivity, so building it never allocates.
+ * A view must not be used after a cell has been added to or updated in the Mesh.
+ **/
+class CellView final {
+private:
+	friend Mesh;
+	const NodeStorage* nodeStorage;
+	const CellData* cellData;
+	const CellType* cellType;
+	const int* firstNodePosition;
+	size_t nodeCount;
+	CellView(const NodeStorage* nodeStorage, const CellData* cellData, const CellType* cellType,
+			const int* firstNodePosition, size_t nodeCount) :
+			nodeStorage(nodeStorage), cellData(cellData), cellType(cellType), firstNodePosition(
+					firstNodePosition), nodeCount(nodeCount) {
+	}
+public:
+	int id() const {
+		return cellData->id;
+	}
+	const CellType& type() const {
+		return *cellType;
+	}
+	bool isvirtual() const {
+		return cellData->isvirtual;
+	}
+	int elementId() const {
+		return cellData->elementId;
+	}
+	int cellTypePosition() const {
+		return cellData->cellTypePosition;
+	}
+	/**
+	 * Vega Position Number of the local Coordinate System of the cell.
+	 **/
+	int cid() const {
+		return cellData->csPos;
+	}
+	bool hasOrientation() const {
+		return cellData->csPos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID;
+	}
+	size_t numNodes() const {
+		return nodeCount;
+	}
+	boost::iterator_range<const int*> nodePositions() const {
+		return boost::make_iterator_range(firstNodePosition, firstNodePosition + nodeCount);
+	}
+	int nodePosition(size_t i) const {
+		return firstNodePosition[i];
+	}
+	int nodeId(size_t i) const {
+		return nodeStorage->nodeDatas[static_cast<size_t>(firstNodePosition[i])].id;
+	}
+};
+
 class Mesh final {
 
 private:
@@ -121,7 +291,33 @@ private:
 	 */
 	map<int, Group*> groupById;
 
+	/**
+	 * Reverse connectivity (node position -> cell positions) in CSR layout, built on
+	 * demand by findCellPositionsOfNode. Only the first adjacencyCellCount cells are
+	 * indexed, cells added afterwards are scanned until the index is rebuilt.
+	 **/
+	mutable std::vector<int> adjacencyOffsets;
+	mutable std::vector<int> adjacentCellPositions;
+	mutable size_t adjacencyCellCount = 0;
+	void buildNodeAdjacency() const;
+	bool isCurrentCellPosition(int cellPosition) const;
+
+	/**
+	 * Global coordinates of the nodes, see getGlobalCoordinates. Valid only when
+	 * globalCoordinatesModel is not null.
+	 **/
+	mutable std::vector<double> globalX;
+	mutable std::vector<double> globalY;
+	mutable std::vector<double> globalZ;
+	mutable const Model* globalCoordinatesModel = nullptr;
+
 	CellGroup * getOrCreateCellGroupForOrientation(const int cid);
+	/**
+	 * Maximum number of nodes or cells sent to MED in a single write.
+	 */
+	static const size_t MED_WRITE_BLOCK_SIZE;
+	static void createMEDBlockFilter(med_idt fid, med_int nentity, med_int nconstituent,
+			size_t first, size_t count, med_filter& filter);
 	void createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
 			vector<Family>& families);
 public:
@@ -173,6 +369,22 @@ public:
 	 * @return Node::UNAVAILABLE_NODE if not found
 	 */
 	int findNodePosition(const int nodeId) const;
+	/**
+	 * Compute the global coordinates of all the nodes at once, one pass per coordinate
+	 * system, and keep them: findNode then reads them instead of transforming the node.
+	 * They are kept until a node is added or invalidateGlobalCoordinates is called.
+	 * Coordinate systems must have been built (Model::finish).
+	 **/
+	void buildGlobalCoordinates(const Model& model) const;
+	/**
+	 * Global coordinates of all the nodes along X (axis 0), Y (1) or Z (2), by position.
+	 * Calls buildGlobalCoordinates if they are not available for this model.
+	 **/
+	const std::vector<double>& getGlobalCoordinates(const Model& model, int axis) const;
+	/**
+	 * Forget the global coordinates, to be called when a coordinate system changes.
+	 **/
+	void invalidateGlobalCoordinates() const;
 	int findOrReserveNode(int nodeId);
 	//returns a set of nodePositions
 	set<int> findOrReserveNodes(const std::set<int>& nodeIds);
@@ -196,7 +408,17 @@ public:
             bool virtualCell = false, const int cpos=CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, int elementId = Cell::UNAVAILABLE_CELL);
     int findCellPosition(int cellId) const;
 	const Cell findCell(int cellPosition) const;
+	/**
+	 * Same as findCell, without copying the node ids and positions.
+	 **/
+	const CellView findCellView(int cellPosition) const;
 	bool hasCell(int cellId) const;
+	/**
+	 * Positions of the cells using the node at nodePosition, in increasing order.
+	 * Cells replaced by updateCell are not returned. The first call builds a reverse
+	 * connectivity index, then the cost is proportional to the number of cells found.
+	 **/
+	std::vector<int> findCellPositionsOfNode(int nodePosition) const;
 
 	/**
 	 * Assign an elementId (an integer) to a group of cells.
@@ -205,6 +427,11 @@ public:
 	void assignElementId(const CellContainer&, int elementId);
 
 	void writeMED(const char* medFileName);
+	/**
+	 * Sort the node positions added out of order to the node groups, see NodeGroup::sortNodePositions().
+	 * Must be done before the groups are read concurrently.
+	 */
+	void sortNodeGroups();
 	void finish();
 	bool validate() const;
 };
@@ -11,6 +11,7 @@
 #include "MeshComponents.h"
 #include "Mesh.h"
 #include "Model.h"
+#include <algorithm>
 #include <string>
 #include <initializer_list>
 #include <boost/lexical_cast.hpp>
@@ -168,31 +169,68 @@ NodeGroup::NodeGroup(Mesh* mesh, const string& name, int groupId, const string&
 
 void NodeGroup::addNode(int nodeId) {
 	int nodePosition = this->mesh->findOrReserveNode(nodeId);
-	_nodePositions.insert(nodePosition);
+	addNodeByPosition(nodePosition);
 }
 
 void NodeGroup::addNodeByPosition(int nodePosition) {
-	_nodePositions.insert(nodePosition);
+	if (sortedCount == _nodePositions.size()
+			&& (_nodePositions.empty() || _nodePositions.back() < nodePosition)) {
+		// nodes often come in increasing order
+		sortedCount++;
+	}
+	_nodePositions.push_back(nodePosition);
+}
+
+void NodeGroup::addNodesByPosition(const vector<int>& nodePositions) {
+	_nodePositions.insert(_nodePositions.end(), nodePositions.begin(), nodePositions.end());
+	sortNodePositions();
+}
+
+void NodeGroup::sortNodePositions() {
+	if (sortedCount == _nodePositions.size()) {
+		return;
+	}
+	const auto middle = _nodePositions.begin() + static_cast<long>(sortedCount);
+	sort(middle, _nodePositions.end());
+	inplace_merge(_nodePositions.begin(), middle, _nodePositions.end());
+	_nodePositions.erase(unique(_nodePositions.begin(), _nodePositions.end()), _nodePositions.end());
+	sortedCount = _nodePositions.size();
 }
 
 void NodeGroup::removeNodeByPosition(int nodePosition) {
-	if (_nodePositions.find(nodePosition) == _nodePositions.end()) {
+	sortNodePositions();
+	const auto it = lower_bound(_nodePositions.begin(), _nodePositions.end(), nodePosition);
+	if (it == _nodePositions.end() || *it != nodePosition) {
 		throw logic_error("Node position not present : " + to_string(nodePosition));
 	}
-	for (auto it = _nodePositions.begin(); it != _nodePositions.end();) {
-		if (*it == nodePosition) {
-			_nodePositions.erase(it);
-			return;
-		} else {
-			it++;
-		}
+	_nodePositions.erase(it);
+	sortedCount--;
+}
+
+bool NodeGroup::containsNodePosition(int nodePosition) const {
+	const auto middle = _nodePositions.begin() + static_cast<long>(sortedCount);
+	return binary_search(_nodePositions.begin(), middle, nodePosition)
+			|| find(middle, _nodePositions.end(), nodePosition) != _nodePositions.end();
+}
+
+size_t NodeGroup::size() const {
+	if (sortedCount == _nodePositions.size()) {
+		return _nodePositions.size();
 	}
+	return nodePositions().size();
 }
 
-const std::set<int> NodeGroup::nodePositions() const {
+const vector<int>& NodeGroup::getNodePositions() const {
+	if (sortedCount != _nodePositions.size()) {
+		throw logic_error("Node group " + getName() + " not sorted, see Mesh::sortNodeGroups()");
+	}
 	return _nodePositions;
 }
 
+const std::set<int> NodeGroup::nodePositions() const {
+	return set<int>(_nodePositions.begin(), _nodePositions.end());
+}
+
 const set<int> NodeGroup::getNodeIds() const {
 	set<int> nodeIds;
 	for (int position : _nodePositions) {
@@ -235,13 +273,14 @@ vector<int> CellGroup::cellPositions() {
 }
 
 const set<int> CellGroup::nodePositions() const {
-	set<int> result;
+	vector<int> result;
 	for (int cellId : cellIds) {
 		int position = mesh->findCellPosition(cellId);
-		Cell cell = mesh->findCell(position);
-		result.insert(cell.nodePositions.begin(), cell.nodePositions.end());
+		const CellView cell = mesh->findCellView(position);
+		result.insert(result.end(), cell.nodePositions().begin(), cell.nodePositions().end());
 	}
-	return result;
+	sort(result.begin(), result.end());
+	return set<int>(result.begin(), unique(result.begin(), result.end()));
 }
 
 CellGroup::~CellGroup() {
@@ -598,11 +637,13 @@ vector<int> CellContainer::getCellIds(bool all) const {
 }
 
 set<int> CellContainer::nodePositions() const {
-	set<int> result;
-	for (Cell cell : getCells(true)) {
-		result.insert(cell.nodePositions.begin(), cell.nodePositions.end());
+	vector<int> result;
+	for (int cellId : getCellIds(true)) {
+		const CellView cell = mesh->findCellView(mesh->findCellPosition(cellId));
+		result.insert(result.end(), cell.nodePositions().begin(), cell.nodePositions().end());
 	}
-	return result;
+	sort(result.begin(), result.end());
+	return set<int>(result.begin(), unique(result.begin(), result.end()));
 }
 
 bool CellContainer::containsCells(CellType cellType, bool all) {
@@ -647,51 +688,89 @@ bool CellContainer::hasCellGroups() const {
 	return groupNames.size() > 0;
 }
 
+FamilyRefinement::FamilyRefinement() {
+	refinements.push_back({0, nullptr});
+	childByParent.push_back(0);
+	groupIndexByParent.push_back(-1);
+}
+
+void FamilyRefinement::startGroup(Group* group) {
+	groupIndex++;
+	currentGroup = group;
+}
+
+int FamilyRefinement::refine(int oldFamily) {
+	if (groupIndexByParent[oldFamily] == groupIndex) {
+		return childByParent[oldFamily];
+	}
+	//family not found, create one
+	const int newFamily = static_cast<int>(refinements.size());
+	refinements.push_back({oldFamily, currentGroup});
+	childByParent.push_back(0);
+	groupIndexByParent.push_back(-1);
+	childByParent[oldFamily] = newFamily;
+	groupIndexByParent[oldFamily] = groupIndex;
+	return newFamily;
+}
+
+vector<Family> FamilyRefinement::buildFamilies(const vector<bool>& inUse, int sign,
+		const string& namePrefix) const {
+	// names are built from the name of the parent, computed once per family
+	vector<string> names(refinements.size());
+	vector<bool> named(refinements.size(), false);
+	vector<int> chain;
+	vector<Family> families;
+	for (size_t familyNum = 1; familyNum < refinements.size(); familyNum++) {
+		if (!inUse[familyNum]) {
+			continue;
+		}
+		chain.clear();
+		for (int num = static_cast<int>(familyNum); num != 0; num = refinements[num].parent) {
+			chain.push_back(num);
+		}
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+			const int num = *it;
+			if (named[num]) {
+				continue;
+			}
+			const Refinement& refinement = refinements[num];
+			if (refinement.parent == 0) {
+				names[num] = refinement.group->getName();
+			} else {
+				names[num] = names[refinement.parent] + "_" + refinement.group->getName();
+				if (names[num].length() >= MED_LNAME_SIZE) {
+					names[num] = namePrefix + lexical_cast<string>(num);
+				}
+			}
+			named[num] = true;
+		}
+		Family fam;
+		fam.num = sign * static_cast<int>(familyNum);
+		fam.name = names[familyNum];
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+			fam.groups.push_back(refinements[*it].group);
+		}
+		families.push_back(fam);
+	}
+	return families;
+}
+
 NodeGroup2Families::NodeGroup2Families(int nnodes, const vector<NodeGroup*> nodeGroups) {
-	int currentFamilyId = 0;
-	unordered_map<int, int> newFamilyByOldfamily;
-	unordered_map<int, Family> familyByFamilyId;
+	FamilyRefinement refinement;
 	if (nnodes > 0 && nodeGroups.size() > 0) {
 		this->nodes.resize(nnodes, 0);
 		for (NodeGroup * nodeGroup : nodeGroups) {
-			newFamilyByOldfamily.clear();
-			for (int nodePosition : nodeGroup->nodePositions()) {
-				int oldFamily = nodes[nodePosition];
-				auto newFamilyPair = newFamilyByOldfamily.find(oldFamily);
-				int newFamilyId;
-				if (newFamilyPair == newFamilyByOldfamily.end()) {
-					//family not found, create one
-					currentFamilyId++;
-					Family fam;
-					auto oldFamilyPair = familyByFamilyId.find(oldFamily);
-					if (oldFamilyPair != familyByFamilyId.end()) {
-						Family& oldFamily = oldFamilyPair->second;
-						fam.groups.insert(fam.groups.begin(), oldFamily.groups.begin(),
-								oldFamily.groups.end());
-						fam.name = oldFamily.name + "_" + nodeGroup->getName();
-						if (fam.name.length() >= MED_LNAME_SIZE) {
-							fam.name = string("Family") + lexical_cast<string>(currentFamilyId);
-						}
-					} else {
-						fam.name = nodeGroup->getName();
-					}
-					newFamilyId = fam.num = currentFamilyId;
-					fam.groups.push_back(nodeGroup);
-					newFamilyByOldfamily.insert(make_pair(oldFamily, currentFamilyId));
-					familyByFamilyId.insert(make_pair(currentFamilyId, fam));
-				} else {
-					newFamilyId = newFamilyPair->second;
-				}
-				nodes[nodePosition] = newFamilyId;
+			refinement.startGroup(nodeGroup);
+			for (int nodePosition : nodeGroup->getNodePositions()) {
+				nodes[nodePosition] = refinement.refine(nodes[nodePosition]);
 			}
 		}
 	}
-	set<int> familiesInUse(nodes.begin(), nodes.end());
-	for (int fam_id : familiesInUse) {
-		if (fam_id != 0) {
-			families.push_back(familyByFamilyId[fam_id]);
-		}
+	vector<bool> familiesInUse(refinement.size(), false);
+	for (int fam_id : nodes) {
+		familiesInUse[fam_id] = true;
 	}
+	families = refinement.buildFamilies(familiesInUse, 1, "Family");
 }
 
 vector<Family>& NodeGroup2Families::getFamilies() {
@@ -705,60 +784,33 @@ vector<int>& NodeGroup2Families::getFamilyOnNodes() {
 CellGroup2Families::CellGroup2Families(
 		const Mesh* mesh, unordered_map<CellType::Code, int, hash<int>> cellCountByType,
 		const vector<CellGroup *>& cellGroups) : mesh(mesh) {
-	int currentFamilyId = 0;
-	unordered_map<int, int> newFamilyByOldfamily;
-	unordered_map<int, Family> familyByFamilyId;
+	FamilyRefinement refinement;
 	for (auto cellCountByTypePair : cellCountByType) {
 		shared_ptr<vector<int>> cells(new vector<int>());
 		cells->resize(cellCountByTypePair.second, 0);
 		cellFamiliesByType[cellCountByTypePair.first] = cells;
 	}
 
+	// cell families are numbered negatively
 	for (CellGroup * cellGroup : cellGroups) {
-		newFamilyByOldfamily.clear();
+		refinement.startGroup(cellGroup);
 		for (auto cellPosition : cellGroup->cellPositions()) {
-			const Cell& cell = mesh->findCell(cellPosition);
-			shared_ptr<vector<int>> currentCellFamilies = cellFamiliesByType[cell.type.code];
-			int oldFamily = currentCellFamilies->at(cell.cellTypePosition);
-			auto newFamilyPair = newFamilyByOldfamily.find(oldFamily);
-			int newFamilyId;
-			if (newFamilyPair == newFamilyByOldfamily.end()) {
-				//family not found, create one
-				currentFamilyId--;
-				Family fam;
-				auto oldFamilyPair = familyByFamilyId.find(oldFamily);
-				if (oldFamilyPair != familyByFamilyId.end()) {
-					Family& oldFamily = oldFamilyPair->second;
-					fam.groups.insert(fam.groups.begin(), oldFamily.groups.begin(),
-							oldFamily.groups.end());
-					fam.name = oldFamily.name + "_" + cellGroup->getName();
-					if (fam.name.length() >= MED_LNAME_SIZE) {
-						fam.name = string("CELLFamily") + lexical_cast<string>(-currentFamilyId);
-					}
-				} else {
-					fam.name = cellGroup->getName();
-				}
-				newFamilyId = fam.num = currentFamilyId;
-				fam.groups.push_back(cellGroup);
-				newFamilyByOldfamily[oldFamily] = currentFamilyId;
-				familyByFamilyId[currentFamilyId] = fam;
-			} else {
-				newFamilyId = newFamilyPair->second;
-			}
-			currentCellFamilies->at(cell.cellTypePosition) = newFamilyId;
+			const CellView cell = mesh->findCellView(cellPosition);
+			vector<int>& currentCellFamilies = *cellFamiliesByType[cell.type().code];
+			int& family = currentCellFamilies.at(cell.cellTypePosition());
+			family = -refinement.refine(-family);
 		}
 	}
 
-	set<int> familiesInUse;
-	for (auto cellFamilyAndTypePair : cellFamiliesByType) {
-		familiesInUse.insert(cellFamilyAndTypePair.second->begin(),
-				cellFamilyAndTypePair.second->end());
-	}
-	for (int fam_id : familiesInUse) {
-		if (fam_id != 0) {
-			families.push_back(familyByFamilyId[fam_id]);
+	vector<bool> familiesInUse(refinement.size(), false);
+	for (const auto& cellFamilyAndTypePair : cellFamiliesByType) {
+		for (int fam_id : *cellFamilyAndTypePair.second) {
+			familiesInUse[-fam_id] = true;
 		}
 	}
+	families = refinement.buildFamilies(familiesInUse, -1, "CELLFamily");
+	// in increasing order of their (negative) numbers
+	reverse(families.begin(), families.end());
 }
 
 vector<Family>& CellGroup2Families::getFamilies() {
@@ -237,9 +237,12 @@ private:
     friend Mesh;
     NodeGroup(Mesh* mesh, const std::string& name, int groupId, const std::string& comment="    ");
     /**
-     * Positions of the nodes participating to the group
+     * Positions of the nodes participating to the group. The first sortedCount ones are
+     * sorted and unique, the others were appended since and wait for sortNodePositions().
+     * Reading the group never modifies it, so it can be done concurrently.
      */
-    std::set<int> _nodePositions;
+    std::vector<int> _nodePositions;
+    size_t sortedCount = 0;
 public:
     /**
      * Add a node using its numerical id. If the node hasn't been yet defined it reserve a
@@ -256,8 +259,30 @@ public:
             begin++;
         }
     }
+    /**
+     * Add a node position in constant time: out of order positions are only appended,
+     * see sortNodePositions().
+     */
     void addNodeByPosition(int nodePosition);
+    /**
+     * Add many node positions at once, duplicates allowed: they are sorted
+     * and merged in a single pass.
+     */
+    void addNodesByPosition(const std::vector<int>& nodePositions);
+    /**
+     * Sort and merge the positions appended out of order. Mesh::sortNodeGroups() does it
+     * for all the groups, before the model is finished or written.
+     */
+    void sortNodePositions();
     void removeNodeByPosition(int nodePosition);
+    bool containsNodePosition(int nodePosition) const;
+    size_t size() const;
+    /**
+     * Sorted positions of the nodes of the group, without copy. Throws if positions were
+     * added out of order since the last sortNodePositions().
+     * The reference is invalidated by any addition or removal.
+     */
+    const std::vector<int>& getNodePositions() const;
     const std::set<int> nodePositions() const override;
     const std::set<int> getNodeIds() const;
 };
@@ -506,6 +531,44 @@ struct Family final {
     int num;
 };
 
+/**
+ * Splits entities into families, one per distinct combination of groups. Groups are applied
+ * one after the other: an entity of family f moves to the child family (f, group), created on
+ * first use. Families are stored as (parent, group) pairs indexed by their number, so a group
+ * costs time proportional to its size only. Family structs are built at the end, for the
+ * families that are still in use.
+ */
+class FamilyRefinement final {
+    struct Refinement {
+        int parent;
+        Group* group;
+    };
+    /**
+     * Index 0 is the empty family of the entities without any group.
+     */
+    std::vector<Refinement> refinements;
+    std::vector<int> childByParent;
+    std::vector<int> groupIndexByParent;
+    int groupIndex = -1;
+    Group* currentGroup = nullptr;
+public:
+    FamilyRefinement();
+    void startGroup(Group* group);
+    /**
+     * Returns the family number of an entity of family oldFamily added to the current group.
+     */
+    int refine(int oldFamily);
+    /**
+     * Builds the families marked in use, with numbers multiplied by sign and names longer
+     * than MED_LNAME_SIZE replaced by namePrefix followed by the family number.
+     */
+    std::vector<Family> buildFamilies(const std::vector<bool>& inUse, int sign,
+            const std::string& namePrefix) const;
+    size_t size() const {
+        return refinements.size();
+    }
+};
+
 class NodeGroup2Families {
     std::vector<Family> families;
     std::vector<int> nodes;
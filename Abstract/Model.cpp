@@ -10,6 +10,7 @@
 
 #include "Model.h"
 
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <fstream>
@@ -17,6 +18,9 @@
 #include <boost/assign.hpp>
 #include <boost/unordered_map.hpp>
 #include <ciso646>
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 
@@ -47,12 +51,19 @@ void Model::Container<T>::add(const T& t) {
 
 template<class T>
 void Model::Container<T>::add(shared_ptr<T> ptr) {
-    if (find(ptr->getReference())) {
+    // Objects are mostly added in creation order: a vega id greater than all the stored ones
+    // cannot be there yet, and is inserted at the end of the map in constant time.
+    const bool isLastId = by_id.empty() || by_id.rbegin()->first < ptr->getId();
+    if ((!isLastId || ptr->isOriginal()) && find(ptr->getReference())) {
         ostringstream oss;
         oss << *ptr << " is already in the model";
         throw runtime_error(oss.str());
     }
-    by_id[ptr->getId()] = ptr;
+    if (isLastId) {
+        by_id.emplace_hint(by_id.end(), ptr->getId(), ptr);
+    } else {
+        by_id[ptr->getId()] = ptr;
+    }
     if (ptr->isOriginal())
         by_original_ids_by_type[ptr->type][ptr->getOriginalId()] = ptr;
 }
@@ -208,6 +219,7 @@ void Model::add(const CoordinateSystem& coordinateSystem) {
     }
     coordinateSystems.add(coordinateSystem);
     coordinateSystemStorage->add(coordinateSystem);
+    mesh->invalidateGlobalCoordinates();
 }
 
 void Model::add(const ElementSet& elementSet) {
@@ -318,61 +330,58 @@ const vector<int> Model::getElementSetsId() const{
 	return v;
 }
 
+template<class T>
+Model::ReferenceKey Model::referenceKey(const Reference<T>& reference) {
+    // the id does not count when there is an original id
+    const int id = (reference.original_id != T::NO_ORIGINAL_ID) ? 0 : reference.id;
+    return ReferenceKey(reference.type, make_pair(reference.original_id, id));
+}
+
 template<>
 void Model::remove(const Reference<Constraint> constraintReference) {
-    for (auto it : constraintReferences_by_constraintSet_ids) {
-        for (auto it2 : it.second) {
-            if (*it2 == constraintReference)
-                constraintReferences_by_constraintSet_ids[it.first].erase(it2);
-        }
-    }
-    for (auto it : constraintReferences_by_constraintSet_original_ids_by_constraintSet_type) {
-        for (auto it2 : it.second) {
-            for (auto it3 : it2.second) {
-                if (*it3 == constraintReference)
-                    constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[it.first][it2.first].erase(
-                            it3);
-            }
+    auto memberships = constraintReferenceMemberships.find(referenceKey(constraintReference));
+    if (memberships != constraintReferenceMemberships.end()) {
+        for (const auto& membership : memberships->second) {
+            membership.first->erase(membership.second);
         }
+        constraintReferenceMemberships.erase(memberships);
     }
     constraints.erase(constraintReference);
 }
 
 void Model::remove(const Reference<Constraint> refC, const int idCS, const int originalIdCS, const ConstraintSet::Type csT) {
 
-    const auto & cR = constraintReferences_by_constraintSet_ids[idCS];
-    for (auto it2 : cR) {
-        if (*it2 == refC){
-            constraintReferences_by_constraintSet_ids[idCS].erase(it2);
-        }
-    }
+    const auto cR = &constraintReferences_by_constraintSet_ids[idCS];
+    set<shared_ptr<Reference<Constraint>>>* cR2 = nullptr;
     if (originalIdCS!= Identifiable<ConstraintSet>::NO_ORIGINAL_ID){
-        const auto & cR2 = constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[csT][originalIdCS];
-        for (auto it3 : cR2) {
-            if (*it3 == refC){
-                constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[csT][originalIdCS].erase(it3);
+        cR2 = &constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[csT][originalIdCS];
+    }
+    auto memberships = constraintReferenceMemberships.find(referenceKey(refC));
+    if (memberships != constraintReferenceMemberships.end()) {
+        auto& sets = memberships->second;
+        for (auto it = sets.begin(); it != sets.end();) {
+            if (it->first == cR || it->first == cR2) {
+                it->first->erase(it->second);
+                it = sets.erase(it);
+            } else {
+                ++it;
             }
         }
+        if (sets.empty()) {
+            constraintReferenceMemberships.erase(memberships);
+        }
     }
     constraints.erase(refC);
 }
 
 template<>
 void Model::remove(const Reference<Loading> loadingReference) {
-    for (auto it : loadingReferences_by_loadSet_ids) {
-        for (auto it2 : it.second) {
-            if (*it2 == loadingReference)
-                loadingReferences_by_loadSet_ids[it.first].erase(it2);
-        }
-    }
-    for (auto it : loadingReferences_by_loadSet_original_ids_by_loadSet_type) {
-        for (auto it2 : it.second) {
-            for (auto it3 : it2.second) {
-                if (*it3 == loadingReference)
-                    loadingReferences_by_loadSet_original_ids_by_loadSet_type[it.first][it2.first].erase(
-                            it3);
-            }
+    auto memberships = loadingReferenceMemberships.find(referenceKey(loadingReference));
+    if (memberships != loadingReferenceMemberships.end()) {
+        for (const auto& membership : memberships->second) {
+            membership.first->erase(membership.second);
         }
+        loadingReferenceMemberships.erase(memberships);
     }
     loadings.erase(loadingReference);
 }
@@ -487,11 +496,17 @@ const shared_ptr<ElementSet> Model::find(const Reference<ElementSet> reference)
 void Model::addLoadingIntoLoadSet(const Reference<Loading>& loadingReference,
         const Reference<LoadSet>& loadSetReference) {
     shared_ptr<Reference<Loading>> loadingReference_ptr = loadingReference.clone();
-    if (loadSetReference.has_id())
-        loadingReferences_by_loadSet_ids[loadSetReference.id].insert(loadingReference_ptr);
-    if (loadSetReference.has_original_id())
-        loadingReferences_by_loadSet_original_ids_by_loadSet_type[loadSetReference.type][loadSetReference.original_id].insert(
-                loadingReference_ptr);
+    auto& memberships = loadingReferenceMemberships[referenceKey(loadingReference)];
+    if (loadSetReference.has_id()) {
+        auto& references = loadingReferences_by_loadSet_ids[loadSetReference.id];
+        if (references.insert(loadingReference_ptr).second)
+            memberships.push_back(make_pair(&references, loadingReference_ptr));
+    }
+    if (loadSetReference.has_original_id()) {
+        auto& references = loadingReferences_by_loadSet_original_ids_by_loadSet_type[loadSetReference.type][loadSetReference.original_id];
+        if (references.insert(loadingReference_ptr).second)
+            memberships.push_back(make_pair(&references, loadingReference_ptr));
+    }
     if (loadSetReference == commonLoadSet.getReference() && !find(commonLoadSet.getReference()))
         add(commonLoadSet); // commonLoadSet is added to the model if needed
     if (!this->find(loadSetReference)) {
@@ -525,12 +540,17 @@ const set<shared_ptr<Loading>> Model::getLoadingsByLoadSet(
 void Model::addConstraintIntoConstraintSet(const Reference<Constraint>& constraintReference,
         const Reference<ConstraintSet>& constraintSetReference) {
     shared_ptr<Reference<Constraint>> constraintReference_ptr = constraintReference.clone();
-    if (constraintSetReference.has_id())
-        constraintReferences_by_constraintSet_ids[constraintSetReference.id].insert(
-                constraintReference_ptr);
-    if (constraintSetReference.has_original_id())
-        constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[constraintSetReference.type][constraintSetReference.original_id].insert(
-                constraintReference_ptr);
+    auto& memberships = constraintReferenceMemberships[referenceKey(constraintReference)];
+    if (constraintSetReference.has_id()) {
+        auto& references = constraintReferences_by_constraintSet_ids[constraintSetReference.id];
+        if (references.insert(constraintReference_ptr).second)
+            memberships.push_back(make_pair(&references, constraintReference_ptr));
+    }
+    if (constraintSetReference.has_original_id()) {
+        auto& references = constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[constraintSetReference.type][constraintSetReference.original_id];
+        if (references.insert(constraintReference_ptr).second)
+            memberships.push_back(make_pair(&references, constraintReference_ptr));
+    }
     if (constraintSetReference == commonConstraintSet.getReference()
             && !find(commonConstraintSet.getReference()))
         add(commonConstraintSet); // commonConstraintSet is added to the model if needed
@@ -708,7 +728,7 @@ void Model::generateDiscrets() {
                 mesh->allowDOFS(node.position, DOFS::ALL_DOFS);
                 int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::POINT1, cellNodes,
                         true);
-                virtualDiscretTRGroup->addCell(mesh->findCell(cellPosition).id);
+                virtualDiscretTRGroup->addCell(mesh->findCellView(cellPosition).id());
             } else {
                 addedDOFS = DOFS::TRANSLATIONS - node.dofs - missingDOFS;
                 if (virtualDiscretTGroup == nullptr) {
@@ -720,7 +740,7 @@ void Model::generateDiscrets() {
                 }
                 int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::POINT1, { node.id },
                         true);
-                virtualDiscretTGroup->addCell(mesh->findCell(cellPosition).id);
+                virtualDiscretTGroup->addCell(mesh->findCellView(cellPosition).id());
                 mesh->allowDOFS(node.position, DOFS::TRANSLATIONS);
             }
         }
@@ -943,7 +963,7 @@ void Model::emulateAdditionalMass() {
             for (auto cell : cells) {
                 int cellPosition = mesh->addCell(Cell::AUTO_ID, cell.type, cell.nodeIds, cell.isvirtual,
                         cell.cid, cell.elementId);
-                newCellGroup->addCell(mesh->findCell(cellPosition).id);
+                newCellGroup->addCell(mesh->findCellView(cellPosition).id());
             }
         }
     }
@@ -977,7 +997,7 @@ void Model::generateBeamsToDisplayHomogeneousConstraint() {
                 for (int slaveNode : rigid->getSlaves()) {
                     nodes[1] = mesh->findNode(slaveNode).id;
                     int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, nodes, true);
-                    virtualGroupRigid->addCell(mesh->findCell(cellPosition).id);
+                    virtualGroupRigid->addCell(mesh->findCellView(cellPosition).id());
                     mesh->allowDOFS(slaveNode, DOFS::ALL_DOFS);
                 }
                 break;
@@ -998,7 +1018,7 @@ void Model::generateBeamsToDisplayHomogeneousConstraint() {
                     nodes[1] = mesh->findNode(slaveNode).id;
                     int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, nodes, true);
                     mesh->allowDOFS(slaveNode, DOFS::ALL_DOFS);
-                    virtualGroupRBE3->addCell(mesh->findCell(cellPosition).id);
+                    virtualGroupRBE3->addCell(mesh->findCellView(cellPosition).id());
                 }
                 break;
             }
@@ -1169,6 +1189,18 @@ void Model::replaceDirectMatrices()
     map<int, DOFS> addedDofsByNode;
     map<int, DOFS> requiredDofsByNode;
     map<int, DOFS> ownedDofsByNode;
+    // DOFS brought to the nodes of a cell by the element sets containing it. Built once,
+    // and kept up to date with the discretes created below.
+    unordered_map<int, DOFS> ownedDofsByCellId;
+    for (const auto elementSet : elementSets) {
+        if (elementSet->cellGroup == nullptr) {
+            continue;
+        }
+        const DOFS owned = (elementSet->isBeam() or elementSet->isShell()) ? DOFS::ALL_DOFS : DOFS::TRANSLATIONS;
+        for (int cellId : elementSet->cellGroup->cellIds) {
+            ownedDofsByCellId[cellId] += owned;
+        }
+    }
     for (auto elementSetM : elementSets) {
         if (!elementSetM->isMatrixElement()) {
             continue;
@@ -1176,39 +1208,35 @@ void Model::replaceDirectMatrices()
         shared_ptr<MatrixElement> matrix = static_pointer_cast<MatrixElement>(elementSetM);
         for (int nodePosition : matrix->nodePositions()) {
             requiredDofsByNode[nodePosition] = DOFS();
-            Node node = mesh->findNode(nodePosition);
             DOFS owned;
-            for (const auto elementSetI : elementSets) {
-                if (elementSetI->cellGroup == nullptr) {
-                    continue;
-                }
-                for (Cell cell : elementSetI->cellGroup->getCells()) {
-                    for (int nodeId : cell.nodeIds) {
-                        if (nodeId == node.id) {
-                            if (elementSetI->isBeam() or elementSetI->isShell()) {
-                                owned += DOFS::ALL_DOFS;
-                            } else {
-                                owned += DOFS::TRANSLATIONS;
-                            }
-                            break;
-                        }
-                    }
+            for (int cellPosition : mesh->findCellPositionsOfNode(nodePosition)) {
+                auto ownedIt = ownedDofsByCellId.find(mesh->findCellView(cellPosition).id());
+                if (ownedIt != ownedDofsByCellId.end()) {
+                    owned += ownedIt->second;
                 }
             }
             ownedDofsByNode[nodePosition] = owned;
         }
+        // Number of segments (node couples) of the matrix around each node, see findInPairs()
+        unordered_map<int, int> segmentCountByNode;
+        for (auto pair : matrix->nodePairs()) {
+            if (pair.first != pair.second) {
+                segmentCountByNode[pair.first]++;
+                segmentCountByNode[pair.second]++;
+            }
+        }
         for (auto pair : matrix->nodePairs()) {
             if (pair.first == pair.second) {
-                if (matrix->findInPairs(pair.first).size() != 0) {
+                if (segmentCountByNode.find(pair.first) != segmentCountByNode.end()) {
                     continue; // will be handled by a segment cell with another node
                 }
                 // single node
                 int nodePosition = pair.first;
                 Node node = mesh->findNode(nodePosition);
                 DOFS requiredDofs = requiredDofsByNode.find(nodePosition)->second;
-                shared_ptr<DOFMatrix> submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
+                const DOFMatrix& submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
                 DiscretePoint discrete(*this, {});
-                for (auto& kv : submatrix->componentByDofs) {
+                for (const auto& kv : submatrix) {
                     double value = kv.second;
                     const vega::DOF dof1 = kv.first.first;
                     const vega::DOF dof2 = kv.first.second;
@@ -1230,7 +1258,9 @@ void Model::replaceDirectMatrices()
                         "MTN" + to_string(matrix_count));
                 discrete.assignCellGroup(matrixGroup);
                 int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, { node.id }, true);
-                matrixGroup->addCell(mesh->findCell(cellPosition).id);
+                const int cellId = mesh->findCellView(cellPosition).id();
+                matrixGroup->addCell(cellId);
+                ownedDofsByCellId[cellId] += DOFS::TRANSLATIONS;
                 if (discrete.hasRotations()) {
                     addedDofsByNode[nodePosition] = DOFS::ALL_DOFS;
                     mesh->allowDOFS(node.position, DOFS::ALL_DOFS);
@@ -1256,7 +1286,10 @@ void Model::replaceDirectMatrices()
                 matrix_count++;
                 int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, { rowNode.id,
                         colNode.id }, true);
-                matrixGroup->addCell(mesh->findCell(cellPosition).id);
+                const int cellId = mesh->findCellView(cellPosition).id();
+                matrixGroup->addCell(cellId);
+                ownedDofsByCellId[cellId] += DOFS::TRANSLATIONS;
+                const int segmentCount = segmentCountByNode.find(pair.first)->second;
                 discrete.assignMaterial(getVirtualMaterial());
                 discrete.assignCellGroup(matrixGroup);
                 if (discrete.hasRotations()) {
@@ -1284,11 +1317,11 @@ void Model::replaceDirectMatrices()
                         } else {
                             colNodePosition = colNode.position;
                         }
-                        shared_ptr<DOFMatrix> submatrix = matrix->findSubmatrix(rowNodePosition,
+                        const DOFMatrix& submatrix = matrix->findSubmatrix(rowNodePosition,
                                 colNodePosition);
-                        for (auto& kv : submatrix->componentByDofs) {
+                        for (const auto& kv : submatrix) {
                             // We are disassembling the matrix, so we must divide the value by the segments
-                            double value = kv.second / static_cast<int>(matrix->findInPairs(pair.first).size());
+                            double value = kv.second / segmentCount;
                             const DOF rowDof = kv.first.first;
                             const DOF colDof = kv.first.second;
                             if (!is_equal(value, 0)) {
@@ -1315,6 +1348,21 @@ void Model::replaceDirectMatrices()
         }
         elementSetsToRemove.push_back(elementSetM);
     }
+    // Every loading contributes to the required DOFS of every added node
+    DOFS requiredByLoadings;
+    for (const auto loading : loadings) {
+        for (int nodePosition : loading->nodePositions()) {
+            requiredByLoadings += loading->getDOFSForNode(nodePosition);
+        }
+    }
+    map<int, DOFS> requiredByConstraintsByNode;
+    for (const auto constraint : constraints) {
+        for (int nodePosition : constraint->nodePositions()) {
+            if (addedDofsByNode.find(nodePosition) != addedDofsByNode.end()) {
+                requiredByConstraintsByNode[nodePosition] += constraint->getDOFSForNode(nodePosition);
+            }
+        }
+    }
     for (auto& kv : addedDofsByNode) {
         int nodePosition = kv.first;
         Node node = this->mesh->findNode(nodePosition);
@@ -1335,17 +1383,10 @@ void Model::replaceDirectMatrices()
             owned = it2->second;
         }
 
-        for (const auto loading : loadings) {
-            for (int nodePosition : loading->nodePositions()) {
-                required += loading->getDOFSForNode(nodePosition);
-            }
-        }
-        for (const auto constraint : constraints) {
-            set<int> constraintNodes = constraint->nodePositions();
-            if (constraintNodes.find(nodePosition) == constraintNodes.end()) {
-                continue;
-            }
-            required += constraint->getDOFSForNode(nodePosition);
+        required += requiredByLoadings;
+        auto it3 = requiredByConstraintsByNode.find(nodePosition);
+        if (it3 != requiredByConstraintsByNode.end()) {
+            required += it3->second;
         }
         DOFS extra = added - owned - required;
         if (extra != DOFS::NO_DOFS) {
@@ -1507,8 +1548,8 @@ void Model::splitDirectMatrices(const unsigned int sizeMax){
 
             // We copy the values
             shared_ptr<MatrixElement> nM = static_pointer_cast<MatrixElement>(newElementSet);
-            shared_ptr<DOFMatrix> dM = matrix->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
+            const DOFMatrix& dM = matrix->findSubmatrix(np.first, np.second);
+            for (const auto& dof : dM){
                 nM->addComponent(nodeIdOfElement[np.first], dof.first.first, nodeIdOfElement[np.second], dof.first.second, dof.second);
             }
 
@@ -1662,7 +1703,7 @@ void Model::makeCellsFromDirectMatrices(){
         }
 
         int cellPosition = mesh->addCell(Cell::AUTO_ID, cellType, vNodeIds, true);
-        matrixGroup->addCell(mesh->findCell(cellPosition).id);
+        matrixGroup->addCell(mesh->findCellView(cellPosition).id());
         
         if (configuration.logLevel >= LogLevel::DEBUG){
            cout << "Built cells, in cellgroup "<<matrixGroup->getName()<<", for Matrix Elements in "<< elementSetM->name<<"."<<endl;
@@ -1707,7 +1748,7 @@ void Model::makeCellsFromRBE(){
                 Node slave = mesh->findNode(position);
                 vector<int> nodes = {master.id, slave.id};
                 int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, nodes, true);
-                group->addCell(mesh->findCell(cellPosition).id);
+                group->addCell(mesh->findCellView(cellPosition).id());
             }
 
             // Removing the constraint from the model.
@@ -1747,7 +1788,7 @@ void Model::makeCellsFromRBE(){
             // Creating a cell and adding it to the CellGroup
             vector<int> nodes = {masterNode.id, slaveNode.id};
             int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, nodes, true);
-            group->addCell(mesh->findCell(cellPosition).id);
+            group->addCell(mesh->findCellView(cellPosition).id());
 
             // Removing the constraint from the model.
             remove(constraint->getReference(), idConstraintSet, originalIdConstraintSet, natConstraintSet);
@@ -1809,7 +1850,7 @@ void Model::makeCellsFromRBE(){
                     groupByCoefByDOFS[sDOFS][sCoef]= group;
                 }
                 groupRBE3=groupByCoefByDOFS[sDOFS][sCoef];
-                groupRBE3->addCell(mesh->findCell(cellPosition).id);
+                groupRBE3->addCell(mesh->findCellView(cellPosition).id());
             }
 
             // Removing the constraint from the model.
@@ -1861,7 +1902,7 @@ void Model::splitElementsByDOFS(){
                     scalarSpring.assignCellGroup(cellGroup);
                     for (const int cellPosition : it.second){
                         scalarSpring.addSpring(cellPosition, it.first.first, it.first.second);
-                        cellGroup->addCell(this->mesh->findCell(cellPosition).id);
+                        cellGroup->addCell(this->mesh->findCellView(cellPosition).id());
                     }
                     elementSetsToAdd.push_back(scalarSpring);
                     i++;
@@ -1886,91 +1927,162 @@ void Model::splitElementsByDOFS(){
         }
 }
 
+namespace {
+
+/**
+ * Peak resident memory of the process in kilobytes, 0 when it is not available.
+ */
+long peakRssKb() {
+#ifdef __linux__
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss;
+    }
+#endif
+    return 0;
+}
+
+}
+
+void Model::runFinishPass(const string& name, const function<void()>& pass) {
+    const long peakRssBefore = peakRssKb();
+    const auto start = chrono::steady_clock::now();
+    pass();
+    FinishPassReport report;
+    report.name = name;
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report.peakRssDeltaKb = peakRssKb() - peakRssBefore;
+    report.nodeCount = mesh->countNodes();
+    report.cellCount = mesh->countCells();
+    report.elementSetCount = elementSets.size();
+    report.constraintCount = constraints.size();
+    report.loadingCount = loadings.size();
+    report.objectiveCount = objectives.size();
+    if (configuration.logLevel >= LogLevel::DEBUG) {
+        cout << "Model::finish pass " << name << ": " << report.seconds << " s" << endl;
+    }
+    finishPassReports.push_back(report);
+}
+
 void Model::finish() {
     if (finished) {
         return;
     }
 
+    /* Node groups were filled in the order of the input file */
+    mesh->sortNodeGroups();
+
     /* Build the coordinate systems from their definition points */
-    for (shared_ptr<CoordinateSystem> coordinateSystem : coordinateSystems) {
-        coordinateSystem->build();
-    }
+    runFinishPass("buildCoordinateSystems", [this]() {
+        for (shared_ptr<CoordinateSystem> coordinateSystem : coordinateSystems) {
+            coordinateSystem->build();
+        }
+        mesh->invalidateGlobalCoordinates();
+    });
 
-    for (shared_ptr<ElementSet> elementSet : elementSets) {
-        for (int nodePosition : elementSet->nodePositions()) {
-            mesh->allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
+    runFinishPass("allowDOFS", [this]() {
+        for (shared_ptr<ElementSet> elementSet : elementSets) {
+            for (int nodePosition : elementSet->nodePositions()) {
+                mesh->allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
+            }
         }
-    }
-    for (shared_ptr<Analysis> analysis : analyses) {
-        for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
-            for(int nodePosition: boundaryCondition->nodePositions()) {
-                analysis->addBoundaryDOFS(nodePosition,
-                        boundaryCondition->getDOFSForNode(nodePosition));
+        for (shared_ptr<Analysis> analysis : analyses) {
+            for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
+                for(int nodePosition: boundaryCondition->nodePositions()) {
+                    analysis->addBoundaryDOFS(nodePosition,
+                            boundaryCondition->getDOFSForNode(nodePosition));
+                }
             }
         }
-    }
+    });
 
-    removeAssertionsMissingDOFS();
+    runFinishPass("removeAssertionsMissingDOFS", [this]() {removeAssertionsMissingDOFS();});
 
     if (this->configuration.emulateLocalDisplacement) {
-        emulateLocalDisplacementConstraint();
+        runFinishPass("emulateLocalDisplacementConstraint",
+                [this]() {emulateLocalDisplacementConstraint();});
     }
 
     if (this->configuration.displayHomogeneousConstraint) {
-        generateBeamsToDisplayHomogeneousConstraint();
+        runFinishPass("generateBeamsToDisplayHomogeneousConstraint",
+                [this]() {generateBeamsToDisplayHomogeneousConstraint();});
     }
 
     if (this->configuration.createSkin) {
-        generateSkin();
+        runFinishPass("generateSkin", [this]() {generateSkin();});
     }
     if (this->configuration.emulateAdditionalMass) {
-        emulateAdditionalMass();
+        runFinishPass("emulateAdditionalMass", [this]() {emulateAdditionalMass();});
     }
 
     if (this->configuration.replaceCombinedLoadSets) {
-        replaceCombinedLoadSets();
+        runFinishPass("replaceCombinedLoadSets", [this]() {replaceCombinedLoadSets();});
     }
 
     if (this->configuration.replaceDirectMatrices) {
-        replaceDirectMatrices();
+        runFinishPass("replaceDirectMatrices", [this]() {replaceDirectMatrices();});
     }
 
     if (this->configuration.removeRedundantSpcs) {
-        removeRedundantSpcs();
+        runFinishPass("removeRedundantSpcs", [this]() {removeRedundantSpcs();});
     }
 
     if (this->configuration.removeIneffectives) {
-        removeIneffectives();
+        runFinishPass("removeIneffectives", [this]() {removeIneffectives();});
     }
 
     if (this->configuration.virtualDiscrets) {
-        generateDiscrets();
+        runFinishPass("generateDiscrets", [this]() {generateDiscrets();});
     }
 
     if (this->configuration.splitDirectMatrices){
-        splitDirectMatrices(this->configuration.sizeDirectMatrices);
+        runFinishPass("splitDirectMatrices",
+                [this]() {splitDirectMatrices(this->configuration.sizeDirectMatrices);});
     }
 
     if (this->configuration.makeCellsFromDirectMatrices){
-        makeCellsFromDirectMatrices();
+        runFinishPass("makeCellsFromDirectMatrices", [this]() {makeCellsFromDirectMatrices();});
     }
 
     if (this->configuration.makeCellsFromRBE){
-        makeCellsFromRBE();
+        runFinishPass("makeCellsFromRBE", [this]() {makeCellsFromRBE();});
     }
 
     if (this->configuration.splitElementsByDOFS){
-        splitElementsByDOFS();
+        runFinishPass("splitElementsByDOFS", [this]() {splitElementsByDOFS();});
         }
 
-    assignElementsToCells();
-    generateMaterialAssignments();
-    addDefaultAnalysis();
+    runFinishPass("assignElementsToCells", [this]() {assignElementsToCells();});
+    runFinishPass("generateMaterialAssignments", [this]() {generateMaterialAssignments();});
+    runFinishPass("addDefaultAnalysis", [this]() {addDefaultAnalysis();});
 
     this->mesh->finish();
     finished = true;
 }
 
+void Model::writeFinishReport(ostream& out) const {
+    double totalSeconds = 0;
+    out << "{" << endl;
+    out << "  \"passes\": [" << endl;
+    for (size_t i = 0; i < finishPassReports.size(); i++) {
+        const FinishPassReport& report = finishPassReports[i];
+        totalSeconds += report.seconds;
+        out << "    {\"name\": \"" << report.name << "\", \"seconds\": " << report.seconds
+                << ", \"peakRssDeltaKb\": " << report.peakRssDeltaKb
+                << ", \"nodes\": " << report.nodeCount
+                << ", \"cells\": " << report.cellCount
+                << ", \"elementSets\": " << report.elementSetCount
+                << ", \"constraints\": " << report.constraintCount
+                << ", \"loadings\": " << report.loadingCount
+                << ", \"objectives\": " << report.objectiveCount << "}"
+                << (i + 1 < finishPassReports.size() ? "," : "") << endl;
+    }
+    out << "  ]," << endl;
+    out << "  \"seconds\": " << totalSeconds << "," << endl;
+    out << "  \"peakRssKb\": " << peakRssKb() << endl;
+    out << "}" << endl;
+}
+
 bool Model::validate() {
     bool meshValid = mesh->validate();
 
@@ -22,6 +22,7 @@
 #include "Value.h"
 #include "Objective.h"
 #include "Reference.h"
+#include <functional>
 #include <string>
 
 namespace vega {
@@ -86,8 +87,29 @@ private:
      * This method splits the ElementSets to have only one direction in each.
      */
     void splitElementsByDOFS();
+    /**
+     * Runs one pass of finish() and appends its statistics to finishPassReports.
+     */
+    void runFinishPass(const std::string& name, const std::function<void()>& pass);
 
 public:
+    /**
+     * Wall time, growth of the peak resident memory and size of the model after
+     * one of the passes of finish().
+     */
+    struct FinishPassReport {
+        std::string name;
+        double seconds;
+        long peakRssDeltaKb; /**< Always 0 on platforms without getrusage() **/
+        int nodeCount;
+        int cellCount;
+        int elementSetCount;
+        int constraintCount;
+        int loadingCount;
+        int objectiveCount;
+    };
+    std::vector<FinishPassReport> finishPassReports; /**< Filled by finish(), in the order of the passes **/
+
     bool finished;
     bool afterValidation = false;
     string name;
@@ -120,6 +142,24 @@ private:
     std::map< int, set<std::shared_ptr<Reference<Constraint>>>>
     constraintReferences_by_constraintSet_ids;
 
+    /**
+     * Key shared by all the equal references (see operator== on Reference): type, original id,
+     * and id only when there is no original id.
+     */
+    typedef std::pair<int, std::pair<int, int>> ReferenceKey;
+    template<class T>
+    static ReferenceKey referenceKey(const Reference<T>&);
+    template<class T>
+    using ReferenceMemberships = std::unordered_map<ReferenceKey,
+    std::vector<std::pair<set<std::shared_ptr<Reference<T>>>*, std::shared_ptr<Reference<T>>>>,
+    boost::hash<ReferenceKey>>;
+    /**
+     * Reverse indexes of the maps above: for each Loading (resp. Constraint), the sets of references
+     * holding it, together with the stored reference. Lets remove() visit only these sets.
+     */
+    ReferenceMemberships<Loading> loadingReferenceMemberships;
+    ReferenceMemberships<Constraint> constraintReferenceMemberships;
+
     template<class T> class Container final {
         std::map<int, std::shared_ptr<T>> by_id;
         std::unordered_map< typename T::Type, std::map<int, std::shared_ptr<T>>,
@@ -252,7 +292,8 @@ private:
         const vector<int> getElementSetsId() const;
         /**
          * Remove any kind of object from the model, by giving a reference.
-         * Very time consuming when the list is big : restrict use to the minimum
+         * Loadings and Constraints are also removed from the sets holding them, in a time
+         * proportional to the number of these sets.
          */
         template<typename T>
         void remove(const Reference<T>);
@@ -354,6 +395,10 @@ private:
          * Method that is called when parsing is complete.
          */
         void finish();
+        /**
+         * Write the statistics of the passes of finish() as a JSON document.
+         */
+        void writeFinishReport(std::ostream&) const;
         /**
          * This method should be called after finish to check if the model
          * is correct. Validation results are printed to stdout/stderr.
@@ -58,7 +58,12 @@ protected:
 	Tokenizer(std::istream& stream, vega::LogLevel logLevel = vega::LogLevel::INFO,
 			const std::string fileName = "UNKNOWN",
 			const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::BEST_EFFORT);
-	std::istream& instrream;
+	/**
+	 * Constructor for Tokenizers which do not read from a stream (memory mapped files, ...)
+	 */
+	Tokenizer(vega::LogLevel logLevel, const std::string fileName,
+			const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::BEST_EFFORT);
+	std::istream* instrream; /**< Input stream, nullptr if the Tokenizer does not read from a stream. **/
 	vega::LogLevel logLevel;
 	std::string fileName;    /**< Current fileName: only used for printout and error managment. **/
 	vega::ConfigurationParameters::TranslationMode translationMode;
@@ -15,7 +15,10 @@
 
 #include "Reference.h"
 #include "Value.h"
+#include <algorithm>
 #include <climits>
+#include <cstdio>
+#include <ostream>
 #include <string>
 #include <cmath>
 #ifdef __GNUC__
@@ -127,5 +130,100 @@ final {
 	 */
 	bool InvertMatrix(const ublas::matrix<double>& input, ublas::matrix<double>& inverse);
 
+	/**
+	 * Characters needed by formatInteger(), sign included.
+	 */
+	const size_t INTEGER_TEXT_SIZE = 20;
+
+	/**
+	 * Writes the decimal text of value just before end, and returns its first character.
+	 * At least INTEGER_TEXT_SIZE characters must be available before end.
+	 * Unlike the streams, it does not go through the locale.
+	 */
+	inline char* formatInteger(long long value, char* end) {
+		char* begin = end;
+		unsigned long long magnitude =
+				value < 0 ?
+						0ull - static_cast<unsigned long long>(value) :
+						static_cast<unsigned long long>(value);
+		do {
+			*--begin = static_cast<char>('0' + magnitude % 10);
+			magnitude /= 10;
+		} while (magnitude != 0);
+		if (value < 0) {
+			*--begin = '-';
+		}
+		return begin;
+	}
+
+	/**
+	 * Buffered text emitter for the large tables of the solver input files.
+	 * Text is accumulated in a pre-sized buffer and handed to the stream in blocks of
+	 * about flushSize characters. Numbers are formatted without the locale-aware
+	 * stream machinery, reals with the precision of the stream.
+	 */
+	class TextBuffer
+	final {
+		std::ostream& out;
+		const size_t flushSize;
+		const int precision;
+		std::string buffer;
+		public:
+		explicit TextBuffer(std::ostream& out, size_t flushSize = 1 << 16) :
+				out(out), flushSize(flushSize), precision(
+						std::min(static_cast<int>(out.precision()), 17)) {
+			buffer.reserve(flushSize + 1024);
+		}
+		TextBuffer(const TextBuffer&) = delete;
+		TextBuffer& operator=(const TextBuffer&) = delete;
+		~TextBuffer() {
+			flush();
+		}
+		TextBuffer& append(char c) {
+			buffer.push_back(c);
+			return *this;
+		}
+		TextBuffer& append(const char* text) {
+			buffer.append(text);
+			return *this;
+		}
+		TextBuffer& append(long long value) {
+			char digits[INTEGER_TEXT_SIZE];
+			char* end = digits + sizeof(digits);
+			buffer.append(formatInteger(value, end), end);
+			return *this;
+		}
+		TextBuffer& append(int value) {
+			return append(static_cast<long long>(value));
+		}
+		TextBuffer& append(double value) {
+			char text[32];
+			const int length = std::snprintf(text, sizeof(text), "%.*g", precision, value);
+			buffer.append(text, static_cast<size_t>(length));
+			return *this;
+		}
+		/**
+		 * Hands the buffer to the stream once it holds flushSize characters.
+		 */
+		void flushIfFull() {
+			if (buffer.size() >= flushSize) {
+				flush();
+			}
+		}
+		void endLine() {
+			buffer.push_back('\n');
+			flushIfFull();
+		}
+		/**
+		 * Hands the buffer to the stream, before writing to the stream directly.
+		 */
+		void flush() {
+			if (!buffer.empty()) {
+				out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				buffer.clear();
+			}
+		}
+	};
+
 		} /* namespace vega */
 #endif /* UTILITY_H_ */
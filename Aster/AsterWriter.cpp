@@ -26,6 +26,21 @@ namespace fs = boost::filesystem;
 namespace vega {
 namespace aster {
 
+namespace {
+
+/**
+ * Appends 'N<position+1>' followed by the separator to the node list in buffer.
+ * The name follows Node::getMedName(), without building a Node.
+ */
+void appendNodeName(TextBuffer& buffer, int nodePosition, const char* separator) {
+	buffer.append("'N").append(nodePosition + 1).append('\'').append(separator);
+	buffer.flushIfFull();
+}
+
+}
+
+const string AsterWriterImpl::CONSTRAINT_NODE_GROUP_COMMENT = "Aster constraint";
+
 AsterWriterImpl::AsterWriterImpl() {
 
 }
@@ -48,6 +63,7 @@ string AsterWriterImpl::writeModel(const shared_ptr<vega::Model> model_ptr,
 	string med_path = asterModel.getOutputFileName(".med");
 	string comm_path = asterModel.getOutputFileName(".comm");
 
+	createConstraintNodeGroups(asterModel);
 	model_ptr->mesh->writeMED(med_path.c_str());
 
 	ofstream comm_file_ofs;
@@ -741,9 +757,11 @@ void AsterWriterImpl::writeDefiContact(const AsterModel& asterModel, ostream& ou
 			for (shared_ptr<Gap::GapParticipation> gapParticipation : gap->getGaps()) {
 				gapCount++;
 				out << "                             _F(";
-				out << "NOEUD='"
-						<< asterModel.model.mesh->findNode(gapParticipation->nodePosition).getMedName()
-						<< "',";
+				out << "NOEUD=";
+				{
+					TextBuffer name(out);
+					appendNodeName(name, gapParticipation->nodePosition, ",");
+				}
 				out << "COEF_IMPO=" << "C" << constraintSet.getId() << "I" << to_string(gapCount)
 						<< ",";
 				out << "COEF_MULT=(";
@@ -776,7 +794,67 @@ void AsterWriterImpl::writeDefiContact(const AsterModel& asterModel, ostream& ou
 	}
 }
 
-void AsterWriterImpl::writeSPC(const AsterModel& asterModel, const ConstraintSet& cset,
+void AsterWriterImpl::createConstraintNodeGroups(const AsterModel& asterModel) {
+	nodeGroupNameByConstraintId.clear();
+	Mesh& mesh = *asterModel.model.mesh;
+	// Drop the groups left by a previous write of the same model, so that they are
+	// built again from the current constraints rather than taken for input groups.
+	for (NodeGroup* nodeGroup : mesh.getNodeGroups()) {
+		if (nodeGroup->getComment() == CONSTRAINT_NODE_GROUP_COMMENT) {
+			mesh.removeGroup(nodeGroup->getName());
+			delete nodeGroup;
+		}
+	}
+	const int groupSize = asterModel.configuration.asterNodeGroupSize;
+	if (groupSize <= 0) {
+		return;
+	}
+	auto createGroup = [&](const Constraint& constraint, const string& prefix, const set<int>& nodePositions) {
+		if (nodePositions.size() < static_cast<size_t>(groupSize)
+				|| nodeGroupNameByConstraintId.find(constraint.getId()) != nodeGroupNameByConstraintId.end()) {
+			return;
+		}
+		const string name = prefix + to_string(constraint.getId());
+		if (mesh.findGroup(name) != nullptr) {
+			// Keep the node list rather than clash with a group of the input model
+			return;
+		}
+		NodeGroup* nodeGroup = mesh.createNodeGroup(name, NodeGroup::NO_ORIGINAL_ID,
+				CONSTRAINT_NODE_GROUP_COMMENT);
+		nodeGroup->addNodesByPosition(vector<int>(nodePositions.begin(), nodePositions.end()));
+		nodeGroupNameByConstraintId[constraint.getId()] = name;
+	};
+	for (auto it : asterModel.model.constraintSets) {
+		const ConstraintSet& constraintSet = *it;
+		for (shared_ptr<Constraint> constraint : constraintSet.getConstraintsByType(Constraint::SPC)) {
+			shared_ptr<const SinglePointConstraint> spc = static_pointer_cast<
+					const SinglePointConstraint>(constraint);
+			if (spc->group == nullptr && !spc->hasReferences()) {
+				createGroup(*spc, "CSPC", spc->nodePositions());
+			}
+		}
+		for (shared_ptr<Constraint> constraint : constraintSet.getConstraintsByType(Constraint::RIGID)) {
+			createGroup(*constraint, "CSOL", constraint->nodePositions());
+		}
+		for (shared_ptr<Constraint> constraint : constraintSet.getConstraintsByType(
+				Constraint::QUASI_RIGID)) {
+			if (static_pointer_cast<QuasiRigidConstraint>(constraint)->isCompletelyRigid()) {
+				createGroup(*constraint, "CSOL", constraint->nodePositions());
+			}
+		}
+		for (shared_ptr<Constraint> constraint : constraintSet.getConstraintsByType(Constraint::RBE3)) {
+			shared_ptr<const RBE3> rbe3 = static_pointer_cast<const RBE3>(constraint);
+			createGroup(*rbe3, "CRBE", rbe3->getSlaves());
+		}
+	}
+}
+
+const string* AsterWriterImpl::findConstraintNodeGroup(const Constraint& constraint) const {
+	auto it = nodeGroupNameByConstraintId.find(constraint.getId());
+	return it == nodeGroupNameByConstraintId.end() ? nullptr : &it->second;
+}
+
+void AsterWriterImpl::writeSPC(const AsterModel&, const ConstraintSet& cset,
 		ostream&out) {
 	const set<shared_ptr<Constraint>> spcs = cset.getConstraintsByType(Constraint::SPC);
 	if (spcs.size() > 0) {
@@ -792,14 +870,16 @@ void AsterWriterImpl::writeSPC(const AsterModel& asterModel, const ConstraintSet
 						<< endl;
 			} else {
 				out << "                             _F(";
-				if (spc->group == nullptr) {
-					out << "NOEUD=(";
+				const string* nodeGroupName = findConstraintNodeGroup(*spc);
+				if (nodeGroupName != nullptr) {
+					out << "GROUP_NO='" << *nodeGroupName << "',";
+				} else if (spc->group == nullptr) {
+					TextBuffer names(out);
+					names.append("NOEUD=(");
 					for (int nodePosition : spc->nodePositions()) {
-						out << "'"
-								<< asterModel.model.mesh->findNode(nodePosition).getMedName()
-								<< "', ";
+						appendNodeName(names, nodePosition, ", ");
 					}
-					out << "),";
+					names.append("),");
 				} else {
 					out << "GROUP_NO='" << spc->group->getName() << "',";
 				}
@@ -825,7 +905,7 @@ void AsterWriterImpl::writeSPC(const AsterModel& asterModel, const ConstraintSet
 		out << "                             )," << endl;
 	}
 }
-void AsterWriterImpl::writeLIAISON_SOLIDE(const AsterModel& asterModel, const ConstraintSet& cset,
+void AsterWriterImpl::writeLIAISON_SOLIDE(const AsterModel&, const ConstraintSet& cset,
 		ostream& out) {
 
 	const set<shared_ptr<Constraint>> rigidConstraints = cset.getConstraintsByType(
@@ -848,11 +928,18 @@ void AsterWriterImpl::writeLIAISON_SOLIDE(const AsterModel& asterModel, const Co
 			shared_ptr<const RigidConstraint> quasiRigidPtr = static_pointer_cast<
 					const RigidConstraint>(constraintPtr);
 
-			out << "                                   _F(NOEUD=(";
-			for (int node : quasiRigidPtr->nodePositions()) {
-				out << "'" << asterModel.model.mesh->findNode(node).getMedName() << "',";
+			const string* nodeGroupName = findConstraintNodeGroup(*quasiRigidPtr);
+			if (nodeGroupName != nullptr) {
+				out << "                                   _F(GROUP_NO='" << *nodeGroupName << "',"
+						<< endl;
+			} else {
+				TextBuffer names(out);
+				names.append("                                   _F(NOEUD=(");
+				for (int node : quasiRigidPtr->nodePositions()) {
+					appendNodeName(names, node, ",");
+				}
+				names.append("),\n");
 			}
-			out << ")," << endl;
 			out << "                                      )," << endl;
 
 		}
@@ -860,7 +947,7 @@ void AsterWriterImpl::writeLIAISON_SOLIDE(const AsterModel& asterModel, const Co
 	}
 }
 
-void AsterWriterImpl::writeRBE3(const AsterModel& asterModel, const ConstraintSet& cset,
+void AsterWriterImpl::writeRBE3(const AsterModel&, const ConstraintSet& cset,
 		ostream& out) {
 	const set<shared_ptr<Constraint>> constraints = cset.getConstraintsByType(Constraint::RBE3);
 	if (constraints.size() > 0) {
@@ -868,9 +955,11 @@ void AsterWriterImpl::writeRBE3(const AsterModel& asterModel, const ConstraintSe
 		for (auto constraint : constraints) {
 			shared_ptr<const RBE3> rbe3 = static_pointer_cast<const RBE3>(constraint);
 			int masterNode = rbe3->getMaster();
-			out << "                                 _F(NOEUD_MAIT='"
-					<< asterModel.model.mesh->findNode(masterNode).getMedName() << "',"
-					<< endl;
+			{
+				TextBuffer names(out);
+				names.append("                                 _F(NOEUD_MAIT=");
+				appendNodeName(names, masterNode, ",\n");
+			}
 			out << "                                    DDL_MAIT=(";
 			DOFS dofs = rbe3->getDOFSForNode(masterNode);
 			if (dofs.contains(DOF::DX))
@@ -888,11 +977,19 @@ void AsterWriterImpl::writeRBE3(const AsterModel& asterModel, const ConstraintSe
 			out << ")," << endl;
 			set<int> slaveNodes = rbe3->getSlaves();
 
-			out << "                                    NOEUD_ESCL=(";
-			for (int slaveNode : slaveNodes) {
-				out << "'" << asterModel.model.mesh->findNode(slaveNode).getMedName() << "',";
+			const string* nodeGroupName = findConstraintNodeGroup(*rbe3);
+			if (nodeGroupName != nullptr) {
+				// The group lists the slaves by increasing position, as the DDL_ESCL and COEF_ESCL below
+				out << "                                    GROUP_NO_ESCL='" << *nodeGroupName << "',"
+						<< endl;
+			} else {
+				TextBuffer names(out);
+				names.append("                                    NOEUD_ESCL=(");
+				for (int slaveNode : slaveNodes) {
+					appendNodeName(names, slaveNode, ",");
+				}
+				names.append("),\n");
 			}
-			out << ")," << endl;
 			out << "                                    DDL_ESCL=(";
 			for (int slaveNode : slaveNodes) {
 				DOFS dofs = rbe3->getDOFSForNode(slaveNode);
@@ -940,7 +1037,7 @@ void AsterWriterImpl::writeRBE3(const AsterModel& asterModel, const ConstraintSe
 	}
 }
 
-void AsterWriterImpl::writeLMPC(const AsterModel& asterModel, const ConstraintSet& cset,
+void AsterWriterImpl::writeLMPC(const AsterModel&, const ConstraintSet& cset,
 		ostream& out) {
 	const set<shared_ptr<Constraint>> lmpcs = cset.getConstraintsByType(Constraint::LMPC);
 	if (lmpcs.size() > 0) {
@@ -948,16 +1045,18 @@ void AsterWriterImpl::writeLMPC(const AsterModel& asterModel, const ConstraintSe
 		for (shared_ptr<Constraint> constraint : lmpcs) {
 			shared_ptr<const LinearMultiplePointConstraint> lmpc = static_pointer_cast<
 					const LinearMultiplePointConstraint>(constraint);
-			out << "                                _F(NOEUD=(";
 			set<int> nodes = lmpc->nodePositions();
-			for (int nodePosition : nodes) {
-				string nodeName = asterModel.model.mesh->findNode(nodePosition).getMedName();
-				DOFS dofs = lmpc->getDOFSForNode(nodePosition);
-				for (int i = 0; i < dofs.size(); i++) {
-					out << "'" << nodeName << "', ";
+			{
+				TextBuffer names(out);
+				names.append("                                _F(NOEUD=(");
+				for (int nodePosition : nodes) {
+					DOFS dofs = lmpc->getDOFSForNode(nodePosition);
+					for (int i = 0; i < dofs.size(); i++) {
+						appendNodeName(names, nodePosition, ", ");
+					}
 				}
+				names.append("),\n");
 			}
-			out << ")," << endl;
 			out << "                                   DDL=(";
 			for (int nodePosition : nodes) {
 				DOFS dofs = lmpc->getDOFSForNode(nodePosition);
@@ -16,6 +16,7 @@
 #include <memory>
 #include <string>
 #include <fstream>
+#include <map>
 #include <boost/filesystem.hpp>
 #include "AsterModel.h"
 #include "../Abstract/Model.h"
@@ -29,6 +30,15 @@ class AsterWriterImpl : public Writer{
 	string mail_name, sigm_noeu, sigm_elno, sief_elga;
 	bool calc_sigm = false;
 	static constexpr const double SMALLEST_RELATIVE_COMPARISON = 1e-7;
+	/**
+	 * Names of the node groups created by createConstraintNodeGroups(), by constraint id.
+	 */
+	std::map<int, std::string> nodeGroupNameByConstraintId;
+	/**
+	 * Comment of the node groups created by createConstraintNodeGroups(), which tells them
+	 * apart from the groups of the input model when the same model is written again.
+	 */
+	static const std::string CONSTRAINT_NODE_GROUP_COMMENT;
 
 	void writeExport(AsterModel& model, std::ostream&);
 	void writeComm(const AsterModel& model, std::ostream&);
@@ -40,6 +50,8 @@ class AsterWriterImpl : public Writer{
 	void writeAffeCaraElemPoutre(const ElementSet&, std::ostream&);
 	void writeAffeCharMeca(const AsterModel&, std::ostream&);
 	void writeDefiContact(const AsterModel&, std::ostream&);
+	void createConstraintNodeGroups(const AsterModel&);
+	const std::string* findConstraintNodeGroup(const Constraint&) const;
 	void writeSPC(const AsterModel&, const ConstraintSet&, std::ostream&);
 	void writeLIAISON_SOLIDE(const AsterModel&, const ConstraintSet&, std::ostream&);
 	void writeRBE3(const AsterModel&, const ConstraintSet&, std::ostream&);
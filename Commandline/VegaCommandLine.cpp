@@ -119,6 +119,12 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
     }
 
     model->finish();
+    if (configuration.finishReport) {
+        const fs::path reportPath = fs::path(configuration.outputPath)
+                / (fs::path(configuration.outputFile).stem().string() + "_finish.json");
+        ofstream reportStream(reportPath.string());
+        model->writeFinishReport(reportStream);
+    }
     bool validationResult = model->validate();
     if (!validationResult
             && configuration.translationMode == ConfigurationParameters::MODE_STRICT) {
@@ -370,10 +376,17 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
     }
 
 
+    int asterNodeGroupSize = vm["aster.NodeGroupSize"].as<int>();
+    if (asterNodeGroupSize < 0) {
+        throw invalid_argument("Aster node group size must be positive, or 0 to never create node groups.");
+    }
+
     if (vm.count("listOptions")){
         cout << "VEGA options for this translation are: "<< endl;
         cout << "\t Output directory: "<< outputDir << endl;
         cout << "\t Verbosity: "<< logLevel << endl;
+        cout << "\t Finish report: "<< (vm.count("finish-report") ? "yes" : "no") << endl;
+        cout << "\t Aster node group size: "<< asterNodeGroupSize << endl;
         cout << "\t Systus RBE2 Translation Mode: "<< systusRBE2TranslationMode << endl;
         cout << "\t Systus RBE2 Rigidity (for penalty mode only): " << (is_equal(systusRBE2Rigidity, Globals::UNAVAILABLE_DOUBLE) ? "auto" : to_string(systusRBE2Rigidity)) << endl;
         cout << "\t Systus RBE Lagrangian (for RBE2 lagrangian mode and RBE3): " << systusRBELagrangian << endl;
@@ -395,7 +408,8 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
             solverVersion, modelName, outputDir, logLevel, translationMode, testFnamePath,
             tolerance, runSolver, solverServer, solverCommand,
             systusRBE2TranslationMode, systusRBE2Rigidity, systusRBELagrangian, systusOptionAnalysis, systusOutputProduct,
-            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod);
+            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod,
+            vm.count("finish-report") > 0, asterNodeGroupSize);
     return configuration;
 }
 
@@ -484,7 +498,16 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
 		        " otherwise it is translated only the mesh.") //
 		("strict,s", "Stops translation at the first "
                 "unrecognized keyword or parameter.")//
-        ("verbosity", po::value<string>(), "Verbosity of VEGA. From low to high: ERROR, WARN, INFO, DEBUG, TRACE"); //
+        ("verbosity", po::value<string>(), "Verbosity of VEGA. From low to high: ERROR, WARN, INFO, DEBUG, TRACE") //
+        ("finish-report", "Write the time, memory and model size after each step of the "
+                "model preparation in OUTPUT_finish.json, in the output directory."); //
+
+        // Code_Aster specific options
+        po::options_description asterOptions("Code_Aster specific options");
+        asterOptions.add_options() //
+        ("aster.NodeGroupSize", po::value<int>()->default_value(1000),
+                "Constraints on at least this number of nodes reference a MED node group (GROUP_NO) "
+                "instead of listing their nodes: default 1000, 0 to always list the nodes."); //
 
         // Systus specific options
         // TODO: Some of these options are not so specific: rename and move them.
@@ -521,10 +544,10 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
                 "output format. Allowed formats are ASTER, SYSTUS");
 
         po::options_description cmdline_options;
-        cmdline_options.add(commandLine).add(generic).add(systusOptions).add(hidden);
+        cmdline_options.add(commandLine).add(generic).add(asterOptions).add(systusOptions).add(hidden);
 
         po::options_description config_file_options;
-        config_file_options.add(generic).add(systusOptions).add(hidden);
+        config_file_options.add(generic).add(asterOptions).add(systusOptions).add(hidden);
 
         po::positional_options_description p;
         p.add("input-file", 1);
@@ -532,7 +555,7 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         p.add("output-format", 1);
 
         po::options_description visible("Options");
-        visible.add(commandLine).add(generic).add(systusOptions);
+        visible.add(commandLine).add(generic).add(asterOptions).add(systusOptions);
 
         po::variables_map vm;
         store(po::command_line_parser(ac, av).options(cmdline_options).positional(p).run(), vm);
@@ -30,6 +30,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <thread>
 #include <ciso646>
 
 namespace vega {
@@ -410,8 +411,10 @@ shared_ptr<Model> NastranParserImpl::parse(const ConfigurationParameters& config
             configuration.getModelConfiguration()));
     map<string, string> executive_section_context;
     const string inputFilePathStr = inputFilePath.string();
-    ifstream istream(inputFilePathStr);
-    NastranTokenizer tok = NastranTokenizer(istream, logLevel, inputFilePath.string(), this->translationMode);
+    NastranTokenizer tok(inputFilePathStr, logLevel, this->translationMode);
+    preloadedIncludes.clear();
+    includesToPreload.clear();
+    nextIncludeToPreload = 0;
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing Executive section." << endl;
@@ -422,8 +425,9 @@ shared_ptr<Model> NastranParserImpl::parse(const ConfigurationParameters& config
         cout << "Parsing BULK section." << endl;
     }
     tok.bulkSection();
+    preloadIncludes(tok);
     parseBULKSection(tok, model);
-    istream.close();
+    preloadedIncludes.clear();
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing finished." << endl;
@@ -709,7 +713,7 @@ void NastranParserImpl::parseCONM2(NastranTokenizer& tok, shared_ptr<Model> mode
     int cellPosition = model->mesh->addCell(elemId, CellType::POINT1, { g });
     string mn = string("CONM2_") + lexical_cast<string>(elemId);
     CellGroup* mnodale = model->mesh->createCellGroup(mn, CellGroup::NO_ORIGINAL_ID, "NODAL MASS");
-    mnodale->addCell(model->mesh->findCell(cellPosition).id);
+    mnodale->addCell(model->mesh->findCellView(cellPosition).id());
     nodalMass.assignCellGroup(mnodale);
     nodalMass.assignMaterial(model->getVirtualMaterial());
 
@@ -1123,23 +1127,62 @@ void NastranParserImpl::parseGRAV(NastranTokenizer& tok, shared_ptr<Model> model
         model->add(loadSet);
     }
 }
-void NastranParserImpl::parseInclude(NastranTokenizer& tok, shared_ptr<Model> model) {
-    string currentRawDataLine = tok.currentRawDataLine();
-    string fileName = currentRawDataLine.substr(7, currentRawDataLine.length() - 7);
+fs::path NastranParserImpl::parseIncludePath(const string& rawDataLine, const string& currentFileName) {
+    string fileName = rawDataLine.substr(7, rawDataLine.length() - 7);
     trim(fileName);
     if (!fileName.compare(0, 1, "'")
             && !fileName.compare(fileName.size() - 1, fileName.size(), "'"))
         fileName = fileName.substr(1, fileName.size() - 2);
-    fs::path currentFname(tok.getFileName());
-    fs::path includePath = currentFname.parent_path() / fileName;
+    fs::path currentFname(currentFileName);
+    return currentFname.parent_path() / fileName;
+}
+
+void NastranParserImpl::preloadIncludes(const NastranTokenizer& tok) {
+    for (const string& rawDataLine : tok.findRawLines("INCLUDE")) {
+        const fs::path includePath = parseIncludePath(rawDataLine, tok.getFileName());
+        if (fs::exists(includePath)) {
+            includesToPreload.push_back(includePath.string());
+        }
+    }
+    if (logLevel >= LogLevel::DEBUG && !includesToPreload.empty()) {
+        cout << "Preloading " << includesToPreload.size() << " include files." << endl;
+    }
+    const size_t workers = max(1u, thread::hardware_concurrency());
+    while (preloadedIncludes.size() < workers && preloadNextInclude()) {
+    }
+}
+
+bool NastranParserImpl::preloadNextInclude() {
+    if (nextIncludeToPreload >= includesToPreload.size()) {
+        return false;
+    }
+    const string includePathStr = includesToPreload[nextIncludeToPreload++];
+    const LogLevel preloadLogLevel = this->logLevel;
+    const ConfigurationParameters::TranslationMode preloadTranslationMode = this->translationMode;
+    preloadedIncludes.emplace_back(includePathStr, async(launch::async,
+            [includePathStr, preloadLogLevel, preloadTranslationMode]() {
+        shared_ptr<NastranTokenizer> tok = make_shared<NastranTokenizer>(includePathStr, preloadLogLevel, preloadTranslationMode);
+        tok->preloadBulkSection();
+        return tok;
+    }));
+    return true;
+}
+
+void NastranParserImpl::parseInclude(NastranTokenizer& tok, shared_ptr<Model> model) {
+    fs::path includePath = parseIncludePath(tok.currentRawDataLine(), tok.getFileName());
     const string includePathStr = includePath.string();
     if (fs::exists(includePath)) {
-        ifstream istream(includePathStr);
-        NastranTokenizer tok2 = NastranTokenizer(istream, this->logLevel, includePathStr, this->translationMode);
-        tok2.bulkSection();
-        tok2.nextLine();
-        parseBULKSection(tok2, model);
-        istream.close();
+        shared_ptr<NastranTokenizer> tok2;
+        if (!preloadedIncludes.empty() && preloadedIncludes.front().first == includePathStr) {
+            tok2 = preloadedIncludes.front().second.get();
+            preloadedIncludes.pop_front();
+            preloadNextInclude();
+        } else {
+            tok2 = make_shared<NastranTokenizer>(includePathStr, this->logLevel, this->translationMode);
+        }
+        tok2->bulkSection();
+        tok2->nextLine();
+        parseBULKSection(*tok2, model);
     } else {
         handleParsingError("Missing include file "+includePathStr, tok, model);
     }
@@ -25,6 +25,8 @@
 #define NASTRANPARSER_H_
 
 #include <boost/filesystem.hpp>
+#include <deque>
+#include <future>
 #include "../Abstract/Model.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "NastranTokenizer.h"
@@ -62,6 +64,23 @@ private:
     void addCellIds(ElementLoading& loading, int eid1, int eid2);
 
     fs::path findModelFile(const string& filename);
+
+    /**
+     * INCLUDE files being tokenized in advance by worker threads, in their order of appearance.
+     * The cards are still parsed into the model in the main thread, in the order of the deck.
+     */
+    std::deque<std::pair<std::string, std::future<std::shared_ptr<NastranTokenizer>>>> preloadedIncludes;
+    std::vector<std::string> includesToPreload;
+    size_t nextIncludeToPreload = 0;
+    /**
+     * Find the INCLUDE cards remaining in tok, and start to preload them.
+     */
+    void preloadIncludes(const NastranTokenizer& tok);
+    /**
+     * Start a worker on the next include file to be preloaded, if any.
+     */
+    bool preloadNextInclude();
+    fs::path parseIncludePath(const string& rawDataLine, const string& currentFileName);
     void parseBULKSection(NastranTokenizer &tok, std::shared_ptr<Model> model1);
 
     void parseExecutiveSection(NastranTokenizer& tok, std::shared_ptr<Model> model, map<string, string>& context);
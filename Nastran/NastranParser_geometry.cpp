@@ -314,7 +314,7 @@ void NastranParserImpl::parseCELAS1(NastranTokenizer& tok, shared_ptr<Model> mod
     connectivity += g1, g2;
     int cellPosition= model->mesh->addCell(eid, CellType::SEG2, connectivity);
     CellGroup* cellGroup = getOrCreateCellGroup(pid, model);
-    cellGroup->addCell(model->mesh->findCell(cellPosition).id);
+    cellGroup->addCell(model->mesh->findCellView(cellPosition).id());
 
     // Creates or update the ElementSet defined by the PELAS key.
     std::shared_ptr<ElementSet> elementSet = model->elementSets.find(pid);
@@ -357,7 +357,7 @@ void NastranParserImpl::parseCELAS2(NastranTokenizer& tok, shared_ptr<Model> mod
     vector<int> connectivity;
     connectivity += g1, g2;
     int cellPosition= model->mesh->addCell(eid, CellType::SEG2, connectivity);
-    springGroup->addCell(model->mesh->findCell(cellPosition).id);
+    springGroup->addCell(model->mesh->findCellView(cellPosition).id());
 
     // Create ElementSet
     ScalarSpring scalarSpring(*model, eid, k ,ge);
@@ -379,7 +379,7 @@ void NastranParserImpl::parseCELAS4(NastranTokenizer& tok, shared_ptr<Model> mod
     vector<int> connectivity;
     connectivity += s1, s2;
     int cellPosition= model->mesh->addCell(eid, CellType::SEG2, connectivity);
-    springGroup->addCell(model->mesh->findCell(cellPosition).id);
+    springGroup->addCell(model->mesh->findCellView(cellPosition).id());
 
     // Create ElementSet
     ScalarSpring scalarSpring(*model, eid, k);
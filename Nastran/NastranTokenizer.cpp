@@ -9,41 +9,108 @@
  */
 
 #include <boost/algorithm/string.hpp>
-#include <boost/tokenizer.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/interprocess/file_mapping.hpp>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <limits>
 #include "NastranTokenizer.h"
 #include "../Abstract/SolverInterfaces.h"
 #include <ciso646>
 
 using namespace std;
-using boost::tokenizer;
-using boost::offset_separator;
 using boost::lexical_cast;
-using boost::trim_copy;
+using boost::string_ref;
+namespace bip = boost::interprocess;
 
 const int NastranTokenizer::UNAVAILABLE_INT = vega::Globals::UNAVAILABLE_INT;
 const double NastranTokenizer::UNAVAILABLE_DOUBLE = vega::Globals::UNAVAILABLE_DOUBLE;
 
+namespace {
+
+inline bool isBlankChar(char c) {
+	return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+string_ref trimView(string_ref field) {
+	while (!field.empty() && isBlankChar(field.front())) {
+		field.remove_prefix(1);
+	}
+	while (!field.empty() && isBlankChar(field.back())) {
+		field.remove_suffix(1);
+	}
+	return field;
+}
+
+bool isBlank(const string_ref& line) {
+	return all_of(line.begin(), line.end(), [](char c) {return isblank(c);});
+}
+
+/**
+ * Split a line on any of the separators, like boost::split, but into views.
+ */
+void splitView(vector<string_ref>& result, const string_ref& line, const char* separators,
+		bool compress = false) {
+	size_t begin = 0;
+	for (size_t i = 0; i < line.size(); i++) {
+		if (strchr(separators, line[i]) != nullptr) {
+			result.push_back(line.substr(begin, i - begin));
+			if (compress) {
+				while (i + 1 < line.size() && strchr(separators, line[i + 1]) != nullptr) {
+					i++;
+				}
+			}
+			begin = i + 1;
+		}
+	}
+	result.push_back(line.substr(begin));
+}
+
+}
+
 NastranTokenizer::NastranTokenizer(istream& stream, vega::LogLevel logLevel, const string fileName,
 		const vega::ConfigurationParameters::TranslationMode translationMode) :
 		Tokenizer(stream, logLevel, fileName, translationMode),
-		currentField(0), currentSection(SECTION_EXECUTIVE) {
+		currentField(0), mappedCursor(nullptr), mappedEnd(nullptr), nextPreloadedCard(0), preloaded(false),
+		keepOwnedLines(false), currentSection(SECTION_EXECUTIVE) {
 	this->nextSymbolType = NastranTokenizer::SYMBOL_KEYWORD;
 }
 
+NastranTokenizer::NastranTokenizer(const string& fileName, vega::LogLevel logLevel,
+		const vega::ConfigurationParameters::TranslationMode translationMode) :
+		Tokenizer(logLevel, fileName, translationMode),
+		currentField(0), mappedCursor(nullptr), mappedEnd(nullptr), nextPreloadedCard(0), preloaded(false),
+		keepOwnedLines(false), currentSection(SECTION_EXECUTIVE) {
+	this->nextSymbolType = NastranTokenizer::SYMBOL_KEYWORD;
+	try {
+		// An empty file can't be mapped: it is simply left unmapped, and read as EOF.
+		if (boost::filesystem::file_size(fileName) > 0) {
+			bip::file_mapping mapping(fileName.c_str(), bip::read_only);
+			bip::mapped_region region(mapping, bip::read_only);
+			mappedRegion.swap(region);
+			mappedRegion.advise(bip::mapped_region::advice_sequential);
+			mappedCursor = static_cast<const char*>(mappedRegion.get_address());
+			mappedEnd = mappedCursor + mappedRegion.get_size();
+		}
+	} catch (std::exception& e) {
+		throw vega::ParsingException(string("Can't map file: ") + e.what(), fileName, 0);
+	}
+}
+
 NastranTokenizer::~NastranTokenizer() {
 }
 
-NastranTokenizer::LineType NastranTokenizer::getLineType(const string& line) {
-	const string beginning = line.substr(0, 8);
-	if (beginning.find(",") == string::npos) {
-		if (beginning.find("*") == string::npos) {
+NastranTokenizer::LineType NastranTokenizer::getLineType(const string_ref& line) {
+	const string_ref beginning = line.substr(0, 8);
+	if (beginning.find(',') == string_ref::npos) {
+		if (beginning.find('*') == string_ref::npos) {
 			return SHORT_FORMAT;
 		} else {
 			return LONG_FORMAT;
@@ -78,17 +145,14 @@ void NastranTokenizer::replaceTabs(string& line, bool longFormat) {
 }
 
 
-string NastranTokenizer::nextSymbolString() {
+string_ref NastranTokenizer::nextSymbol() {
 
     if (this->currentField >= this->currentLineVector.size()){
         this->nextSymbolType = SYMBOL_KEYWORD;
-        return "";
+        return string_ref();
     }
 
-    string result = boost::trim_right_copy(currentLineVector[currentField]);
-    if (this->nextSymbolType == SYMBOL_KEYWORD) {
-        boost::to_upper(result);
-    }
+    string_ref result = currentLineVector[currentField];
     this->nextSymbolType = SYMBOL_FIELD;
     this->currentField++;
     if (this->currentField >= this->currentLineVector.size()){
@@ -98,20 +162,50 @@ string NastranTokenizer::nextSymbolString() {
     return result;
 }
 
-bool NastranTokenizer::readLineSkipComment(string& line) {
+bool NastranTokenizer::readRawLine(string_ref& line) {
+	if (this->instrream == nullptr) {
+		if (mappedCursor >= mappedEnd) {
+			return false;
+		}
+		const char* eol = static_cast<const char*>(memchr(mappedCursor, '\n',
+				static_cast<size_t>(mappedEnd - mappedCursor)));
+		const char* lineEnd = (eol == nullptr) ? mappedEnd : eol;
+		line = string_ref(mappedCursor, static_cast<size_t>(lineEnd - mappedCursor));
+		mappedCursor = (eol == nullptr) ? mappedEnd : eol + 1;
+		return true;
+	}
+	ownedLines.emplace_back();
+	if (!getline(*this->instrream, ownedLines.back())) {
+		ownedLines.pop_back();
+		return false;
+	}
+	line = ownedLines.back();
+	return true;
+}
+
+char NastranTokenizer::peekChar() {
+	if (this->instrream == nullptr) {
+		return (mappedCursor < mappedEnd) ? *mappedCursor : static_cast<char>(EOF);
+	}
+	return static_cast<char>(this->instrream->peek());
+}
+
+string_ref NastranTokenizer::ownLine(const string& line) {
+	ownedLines.push_back(line);
+	return ownedLines.back();
+}
+
+bool NastranTokenizer::readLineSkipComment(string_ref& line) {
 	bool eof = true;
-	while (getline(this->instrream, line)) {
+	while (readRawLine(line)) {
 		lineNumber += 1;
-		if (!line.empty() and !all_of(line.begin(), line.end(), [](int c) {return isblank(c);})
-				and line[0] != '$') {
-			boost::iterator_range<string::iterator> middle_dollar = boost::find_first(line, "$");
-			if (middle_dollar) {
-				boost::erase_tail(line,
-						static_cast<int>(line.size())
-								- static_cast<int>(distance(line.begin(), middle_dollar.begin())));
+		if (!line.empty() and !isBlank(line) and line[0] != '$') {
+			size_t middle_dollar = line.find('$');
+			if (middle_dollar != string_ref::npos) {
+				line = line.substr(0, middle_dollar);
 			}
 			//if the line is not blank exit the loop
-			if (!boost::all(line, [](int c) { return isblank(c); })){
+			if (!isBlank(line)){
 				eof = false;
 				break;
 			}
@@ -120,33 +214,35 @@ bool NastranTokenizer::readLineSkipComment(string& line) {
 	return eof;
 }
 
-void NastranTokenizer::splitFreeFormat(string line, bool firstLine) {
+void NastranTokenizer::splitFreeFormat(string_ref line, bool firstLine) {
+	vector<string_ref> lineFields;
 	if (firstLine) {
-		split(currentLineVector, line, boost::is_any_of(","));
+		splitView(lineFields, line, ",");
 	} else {
 		//skip first field;
-		string lineNoContinuation = line.substr(line.find(',') + 1);
-		vector<string> otherLine;
-		split(otherLine, lineNoContinuation, boost::is_any_of(","));
-		currentLineVector.insert(currentLineVector.end(), otherLine.begin(), otherLine.end());
+		size_t firstComma = line.find(',');
+		splitView(lineFields, (firstComma == string_ref::npos) ? line : line.substr(firstComma + 1), ",");
+	}
+	for (const string_ref& field : lineFields) {
+		currentLineVector.push_back(trimView(field));
 	}
 	bool explicitContinuation = false;
 	for (size_t fieldIndex = 1; fieldIndex < currentLineVector.size(); fieldIndex += 8) {
-		string field = trim_copy(currentLineVector[fieldIndex]);
-		if (field[0] == '+') {
+		const string_ref& field = currentLineVector[fieldIndex];
+		if (!field.empty() && field[0] == '+') {
 			explicitContinuation = true;
 			currentLineVector.erase(currentLineVector.begin() + fieldIndex);
 		}
 	}
-	char c = static_cast<char>(this->instrream.peek());
-	string line2;
+	char c = peekChar();
+	string_ref line2;
     if (explicitContinuation || c == ',' || c == '+' || c == '*') {
 		readLineSkipComment(line2);
 		splitFreeFormat(line2, false);
 	}
 }
 
-void NastranTokenizer::parseBulkSectionLine(string line) {
+void NastranTokenizer::parseBulkSectionLine(string_ref line) {
 	LineType lineType = getLineType(line);
 	switch (lineType) {
 	case LONG_FORMAT:
@@ -182,33 +278,73 @@ void NastranTokenizer::bulkSection() {
 	}
 }
 
+void NastranTokenizer::preloadBulkSection() {
+	bulkSection();
+	keepOwnedLines = true;
+	try {
+		for (nextLine(); this->nextSymbolType != SYMBOL_EOF; nextLine()) {
+			preloadedCards.push_back({preloadedFields.size(), currentLineVector.size(), currentLine, lineNumber});
+			preloadedFields.insert(preloadedFields.end(), currentLineVector.begin(), currentLineVector.end());
+		}
+	} catch (...) {
+		preloadError = current_exception();
+	}
+	currentLineVector.clear();
+	currentField = 0;
+	nextPreloadedCard = 0;
+	preloaded = true;
+}
+
+vector<string> NastranTokenizer::findRawLines(const string& keyword) const {
+	vector<string> result;
+	const auto startsWithKeyword = [&keyword](const string_ref& line) {
+		return line.size() >= keyword.size() && equal(keyword.begin(), keyword.end(), line.begin(),
+				[](char k, char c) {return toupper(static_cast<unsigned char>(k)) == toupper(static_cast<unsigned char>(c));});
+	};
+	if (startsWithKeyword(currentLine)) {
+		result.push_back(currentLine.to_string());
+	}
+	for (const char* line = mappedCursor; line < mappedEnd;) {
+		const char* eol = static_cast<const char*>(memchr(line, '\n', static_cast<size_t>(mappedEnd - line)));
+		const char* lineEnd = (eol == nullptr) ? mappedEnd : eol;
+		const string_ref rawLine(line, static_cast<size_t>(lineEnd - line));
+		if (startsWithKeyword(rawLine)) {
+			result.push_back(rawLine.to_string());
+		}
+		line = (eol == nullptr) ? mappedEnd : eol + 1;
+	}
+	return result;
+}
+
 void NastranTokenizer::parseParameters() {
-	split(currentLineVector, this->currentLine, boost::is_any_of("\\="));
+	currentLineVector.clear();
+	splitView(currentLineVector, this->currentLine, "\\=");
 }
 
 bool NastranTokenizer::isNextInt() {
 	if (nextSymbolType != NastranTokenizer::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	return !curField.empty() && (strspn(curField.c_str(), "-0123456789") == curField.size());
+	const string_ref& curField = currentLineVector[currentField];
+	return !curField.empty() && all_of(curField.begin(), curField.end(),
+			[](char c) {return c == '-' || (c >= '0' && c <= '9');});
 }
 
 bool NastranTokenizer::isNextDouble() {
 	if (nextSymbolType != NastranTokenizer::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	boost::algorithm::erase_all(curField, " ");
-	return !curField.empty() && (strspn(curField.c_str(), "-+0123456789.eEdD") == curField.size());
+	// Fields are trimmed: a non empty field always holds a non blank character
+	const string_ref& curField = currentLineVector[currentField];
+	return !curField.empty() && all_of(curField.begin(), curField.end(),
+			[](char c) {return c == ' ' || strchr("-+0123456789.eEdD", c) != nullptr;});
 }
 
 bool NastranTokenizer::isNextEmpty() {
 	if (nextSymbolType != NastranTokenizer::SYMBOL_FIELD) {
 		return false;
 	}
-	string curField = trim_copy(currentLineVector[currentField]);
-	return curField.empty();
+	return currentLineVector[currentField].empty();
 }
 
 bool NastranTokenizer::isEmptyUntilNextKeyword() {
@@ -219,8 +355,7 @@ bool NastranTokenizer::isEmptyUntilNextKeyword() {
 	}
 	bool result = true;
 	for (size_t i = currentField; i < this->currentLineVector.size() && result; i++) {
-		string curField = trim_copy(currentLineVector[i]);
-		result &= curField.empty();
+		result &= currentLineVector[i].empty();
 	}
 	return result;
 }
@@ -231,13 +366,34 @@ void NastranTokenizer::nextLine() {
 //enough in 99% of lines
 	currentLineVector.reserve(128);
 	currentField = 0;
+	if (preloaded) {
+		if (nextPreloadedCard < preloadedCards.size()) {
+			const PreloadedCard& card = preloadedCards[nextPreloadedCard++];
+			const auto firstField = preloadedFields.begin() + static_cast<ptrdiff_t>(card.firstField);
+			currentLineVector.assign(firstField, firstField + static_cast<ptrdiff_t>(card.fieldCount));
+			this->currentLine = card.rawLine;
+			this->lineNumber = card.lineNumber;
+			this->nextSymbolType = SYMBOL_KEYWORD;
+		} else if (preloadError) {
+			exception_ptr error = preloadError;
+			preloadError = nullptr;
+			rethrow_exception(error);
+		} else {
+			this->nextSymbolType = SYMBOL_EOF;
+		}
+		return;
+	}
+	if (!keepOwnedLines) {
+		// Previous card is over: its views are not used anymore
+		ownedLines.clear();
+	}
 
 	bool iseof = readLineSkipComment(this->currentLine);
 	if (!iseof) {
 		switch (currentSection) {
 		case SECTION_EXECUTIVE:
-			boost::algorithm::trim(this->currentLine);
-			split(currentLineVector, this->currentLine, boost::is_any_of("\t\\= "), boost::algorithm::token_compress_on);
+			this->currentLine = trimView(this->currentLine);
+			splitView(currentLineVector, this->currentLine, "\t\\= ", true);
 			break;
 		case SECTION_BULK:
 			parseBulkSectionLine(this->currentLine);
@@ -249,46 +405,59 @@ void NastranTokenizer::nextLine() {
 	}
 }
 
-void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, const bool firstLine) {
-	boost::offset_separator f;
+void NastranTokenizer::splitFixedFormat(string_ref line, const bool longFormat, const bool firstLine) {
+	static const size_t shortOffsets[] = { SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE };
+	static const size_t longOffsets[] = { SFSIZE, LFSIZE, LFSIZE, LFSIZE, LFSIZE, SFSIZE };
 
+	const size_t* offsets;
+	size_t offsetNum;
 	int fieldMax;
 	if (longFormat) {
-		int offsets[] = { SFSIZE, LFSIZE, LFSIZE, LFSIZE, LFSIZE, SFSIZE };
+		offsets = longOffsets;
+		offsetNum = 6;
 		fieldMax = 5;
-		f = offset_separator(offsets, offsets + 6);
 	} else {
-		int offsets[] = { SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE, SFSIZE };
+		offsets = shortOffsets;
+		offsetNum = 10;
 		fieldMax = 9;
-		f = offset_separator(offsets, offsets + 10);
 	}
 
-	replaceTabs(line, longFormat);
-	tokenizer<offset_separator> tok(line, f);
-	tokenizer<offset_separator>::iterator beg = tok.begin();
+	if (line.find('\t') != string_ref::npos) {
+		string expandedLine(line.begin(), line.end());
+		replaceTabs(expandedLine, longFormat);
+		line = ownLine(expandedLine);
+	}
+	// Cut the line in fixed width fields. Offsets wrap around, as boost::offset_separator does.
+	vector<string_ref> fields;
+	for (size_t pos = 0, i = 0; pos < line.size(); pos += offsets[i], i = (i + 1) % offsetNum) {
+		fields.push_back(line.substr(pos, offsets[i]));
+	}
+	auto beg = fields.begin();
 	int count = 0;
-	if (!firstLine) {
+	if (!firstLine && beg != fields.end()) {
 		//todo:check that explicit continuation tokens are the same
 		++beg;
 		count++;
 	}
 	bool explicitContinuation = false;
-	for (; beg != tok.end(); ++beg) {
-		string trimCopy = trim_copy(*beg);
+	for (; beg != fields.end(); ++beg) {
+		string_ref trimmed = trimView(*beg);
 		//erase all the long format specifiers
-		if (count == 0) {
-			boost::erase_all(trimCopy, "*");
+		if (count == 0 && trimmed.find('*') != string_ref::npos) {
+			string keyword(trimmed.begin(), trimmed.end());
+			boost::erase_all(keyword, "*");
+			trimmed = ownLine(keyword);
 		}
-		currentLineVector.push_back(trimCopy);
+		currentLineVector.push_back(trimmed);
 		if (++count == fieldMax) {
-			explicitContinuation = (++beg != tok.end()) && !(trim_copy(*beg).empty());
+			explicitContinuation = (++beg != fields.end()) && !(trimView(*beg).empty());
 			if (explicitContinuation && this->logLevel >= vega::LogLevel::TRACE) {
 				cout << "explicitContinuation" << endl;
 			}
 			break;
 		}
 	}
-	string line2;
+	string_ref line2;
 	if (explicitContinuation) {
 		//todo:check that continuation tokens are the same
 		bool iseof = readLineSkipComment(line2);
@@ -301,12 +470,12 @@ void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, con
 		/** Test for automatic continuation : we allow tabulation
 		 *  Even if it's, strictly speaking, not authorized by Nastran
 		 */
-		char c = static_cast<char>(this->instrream.peek());
+		char c = peekChar();
 		if (c == ' ' || c == '+' || c == '*' || c=='\t') {
 			readLineSkipComment(line2);
 			//fill the current line with empty fields
 			for (; count < fieldMax; count++) {
-				currentLineVector.push_back("");
+				currentLineVector.push_back(string_ref());
 			}
 			bool longFormat = (c == '*');
 			splitFixedFormat(line2, longFormat, false);
@@ -316,9 +485,8 @@ void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, con
 }
 
 string NastranTokenizer::nextString(bool returnDefaultIfNotFoundOrBlank, string defaultValue) {
-    string value =  trim_copy(nextSymbolString());
-    boost::to_upper(value);
-    if (value.empty()) {
+    string_ref field = nextSymbol();
+    if (field.empty()) {
         if (returnDefaultIfNotFoundOrBlank){
             return defaultValue;
         }else{
@@ -326,6 +494,8 @@ string NastranTokenizer::nextString(bool returnDefaultIfNotFoundOrBlank, string
             handleParsingError(message);
         }
     }
+    string value(field.begin(), field.end());
+    boost::to_upper(value);
     return value;
 }
 
@@ -355,9 +525,95 @@ void NastranTokenizer::skipToNextKeyword() {
 }
 
 
+bool NastranTokenizer::decodeInt(const string_ref& field, int& value) {
+	size_t i = 0;
+	bool negative = false;
+	if (!field.empty() && (field[0] == '+' || field[0] == '-')) {
+		negative = (field[0] == '-');
+		i++;
+	}
+	if (i == field.size()) {
+		return false;
+	}
+	const long long limit = static_cast<long long>(numeric_limits<int>::max()) + (negative ? 1 : 0);
+	long long result = 0;
+	for (; i < field.size(); i++) {
+		const char c = field[i];
+		if (c < '0' || c > '9') {
+			return false;
+		}
+		result = result * 10 + (c - '0');
+		if (result > limit) {
+			return false;
+		}
+	}
+	value = static_cast<int>(negative ? -result : result);
+	return true;
+}
+
+bool NastranTokenizer::decodeDouble(const string_ref& field, double& value) {
+	// The normalized value is at most one character ("E") longer than the field.
+	char smallBuffer[40];
+	vector<char> largeBuffer;
+	char* buffer = smallBuffer;
+	if (field.size() + 2 > sizeof(smallBuffer)) {
+		largeBuffer.resize(field.size() + 2);
+		buffer = largeBuffer.data();
+	}
+	size_t length = 0;
+	bool mantissaDigits = false;
+	bool dot = false;
+	bool exponent = false;
+	bool exponentDigits = false;
+	for (const char c : field) {
+		if (c >= '0' && c <= '9') {
+			if (exponent) {
+				exponentDigits = true;
+			} else {
+				mantissaDigits = true;
+			}
+			buffer[length++] = c;
+		} else if (c == '.') {
+			if (dot || exponent) {
+				return false;
+			}
+			dot = true;
+			buffer[length++] = c;
+		} else if (c == 'E' || c == 'e' || c == 'D' || c == 'd') {
+			if (exponent || !mantissaDigits) {
+				return false;
+			}
+			exponent = true;
+			buffer[length++] = 'E';
+		} else if (c == '+' || c == '-') {
+			if (length == 0) {
+				// sign of the mantissa
+			} else if (exponent && buffer[length - 1] == 'E') {
+				// sign of an explicit exponent
+			} else if (!exponent && mantissaDigits) {
+				// implicit exponent: 1.5-3
+				exponent = true;
+				buffer[length++] = 'E';
+			} else {
+				return false;
+			}
+			buffer[length++] = c;
+		} else if (c != ' ') {
+			return false;
+		}
+	}
+	if (!mantissaDigits || (exponent && !exponentDigits)) {
+		return false;
+	}
+	buffer[length] = '\0';
+	errno = 0;
+	value = strtod(buffer, nullptr);
+	return !(errno == ERANGE && std::abs(value) > 1.0);
+}
+
 int NastranTokenizer::nextInt(bool returnDefaultIfNotFoundOrBlank, int defaultValue) {
-	int result;
-	string value = trim_copy(nextSymbolString());
+	int result = defaultValue;
+	string_ref value = nextSymbol();
 	if (value.empty()) {
 	    if (returnDefaultIfNotFoundOrBlank){
 	        return defaultValue;
@@ -366,12 +622,10 @@ int NastranTokenizer::nextInt(bool returnDefaultIfNotFoundOrBlank, int defaultVa
 	        handleParsingError(message);
 	    }
 	}
-	try {
-		result = lexical_cast<int>(value);
-	} catch (boost::bad_lexical_cast &) {
+	if (!decodeInt(value, result)) {
 		string currentFieldstr =
 				currentField == 0 ? string("LAST") : (lexical_cast<string>(currentField - 1));
-		string message = "Value [" + value + "] can't be converted to int. Field Num: "
+		string message = "Value [" + value.to_string() + "] can't be converted to int. Field Num: "
 				+ currentFieldstr;
 		handleParsingError(message);
 	}
@@ -379,8 +633,8 @@ int NastranTokenizer::nextInt(bool returnDefaultIfNotFoundOrBlank, int defaultVa
 }
 
 double NastranTokenizer::nextDouble(bool returnDefaultIfNotFoundOrBlank, double defaultValue) {
-	double result;
-	string value = trim_copy(nextSymbolString());
+	double result = defaultValue;
+	string_ref value = nextSymbol();
 	if (value.empty()) {
 	    if (returnDefaultIfNotFoundOrBlank){
 	        return defaultValue;
@@ -389,20 +643,10 @@ double NastranTokenizer::nextDouble(bool returnDefaultIfNotFoundOrBlank, double
 	        handleParsingError(message);
 	    }
 	}
-
-	boost::replace_all(value, "d", "e");
-	boost::replace_all(value, "D", "E");
-	boost::algorithm::erase_all(value, " ");
-	size_t position = value.find_first_of("+-", 1);
-	if (position != string::npos and position != value.find_first_of("eE", 1) + 1) {
-		value.insert(position, "E");
-	}
-	try {
-		result = lexical_cast<double>(value);
-	} catch (boost::bad_lexical_cast &) {
+	if (!decodeDouble(value, result)) {
 		string currentFieldstr =
 				currentField == 0 ? string("LAST") : (lexical_cast<string>(currentField - 1));
-		string message = "Value [" + value + "] can't be converted to double. Field Num: "
+		string message = "Value [" + value.to_string() + "] can't be converted to double. Field Num: "
 				+ currentFieldstr;
 		handleParsingError(message);
 	}
@@ -410,9 +654,14 @@ double NastranTokenizer::nextDouble(bool returnDefaultIfNotFoundOrBlank, double
 }
 
 vector<string> NastranTokenizer::currentDataLine() const {
-	return currentLineVector;
+	vector<string> result;
+	result.reserve(currentLineVector.size());
+	for (const string_ref& field : currentLineVector) {
+		result.push_back(field.to_string());
+	}
+	return result;
 }
 
 const string NastranTokenizer::currentRawDataLine() const {
-	return this->currentLine;
+	return this->currentLine.to_string();
 }
@@ -29,6 +29,10 @@
 #include <vector>
 #include <iostream>
 #include <limits>
+#include <deque>
+#include <exception>
+#include <boost/utility/string_ref.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include "../Abstract/ConfigurationParameters.h"
 #include "../Abstract/SolverInterfaces.h"
 
@@ -45,25 +49,62 @@ private:
     static const int LFSIZE = 16;/**< Long field size **/
 
     unsigned int currentField;   /**< Current position of the Tokenizer, i.e, the next field to be interpreted **/
-    std::vector<std::string> currentLineVector;
-    std::string currentLine;
+    /**
+     * Fields of the current line. They are trimmed, non-owning views either into the mapped file,
+     * or into ownedLines when the line could not be used in place (stream input, tabulations...).
+     */
+    std::vector<boost::string_ref> currentLineVector;
+    boost::string_ref currentLine;
+    std::deque<std::string> ownedLines; /**< Storage for the lines of the current card which are not mapped. **/
 
-    NastranTokenizer::LineType getLineType(const std::string& line); /**< Determine the LineType of the line.**/
+    boost::interprocess::mapped_region mappedRegion; /**< Mapped input file, if any. **/
+    const char* mappedCursor; /**< Beginning of the next line to be read in the mapped file. **/
+    const char* mappedEnd;
+
+    /**
+     * Card read in advance by preloadBulkSection(): its fields are stored in preloadedFields.
+     */
+    struct PreloadedCard {
+        size_t firstField;
+        size_t fieldCount;
+        boost::string_ref rawLine;
+        int lineNumber;
+    };
+    std::vector<boost::string_ref> preloadedFields;
+    std::vector<PreloadedCard> preloadedCards;
+    size_t nextPreloadedCard;
+    bool preloaded; /**< If true, nextLine() replays the preloaded cards instead of reading the input. **/
+    bool keepOwnedLines; /**< If true, owned lines are kept for the whole file instead of the current card. **/
+    std::exception_ptr preloadError; /**< Error met while preloading, thrown when its card is reached. **/
+
+    NastranTokenizer::LineType getLineType(const boost::string_ref& line); /**< Determine the LineType of the line.**/
     void replaceTabs(std::string &line, bool longFormat); /**< Replace all tabulation by the needed number of space. **/
 
-    void splitFixedFormat(std::string& line, bool longFormat, bool firstLine);
+    void splitFixedFormat(boost::string_ref line, bool longFormat, bool firstLine);
 
-    bool readLineSkipComment(std::string& line);
-    void splitFreeFormat(std::string line, bool firstLine);
-    void parseBulkSectionLine(std::string line);
+    /**
+     * Read the next raw line, either from the mapped file or from the stream.
+     * Return false at the end of file.
+     */
+    bool readRawLine(boost::string_ref& line);
+    bool readLineSkipComment(boost::string_ref& line);
+    /**
+     * Return the next character of the input without consuming it.
+     */
+    char peekChar();
+    /**
+     * Copy a line into the owned storage, and return a view on the copy.
+     */
+    boost::string_ref ownLine(const std::string& line);
+    void splitFreeFormat(boost::string_ref line, bool firstLine);
+    void parseBulkSectionLine(boost::string_ref line);
     void parseParameters();
 
     /**
-     * Return the next symbol to be interpreted, as a string (trimmed + uppercase), and advances to next field
-     * Return a void string if it's the end of the line.
+     * Return the next symbol to be interpreted, as a view on the trimmed field, and advances to next field
+     * Return a void view if it's the end of the line.
      */
-    //string nextBulkString();
-    std::string nextSymbolString();
+    boost::string_ref nextSymbol();
 
 public:
     enum SymbolType {
@@ -86,8 +127,26 @@ public:
     NastranTokenizer(std::istream& stream, vega::LogLevel logLevel = vega::LogLevel::INFO,
             const std::string fileName = "UNKNOWN",
             const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::BEST_EFFORT);
+    /**
+     * Build a Tokenizer which maps the file in memory: fields are then read in place,
+     * without any copy of the lines.
+     */
+    NastranTokenizer(const std::string& fileName, vega::LogLevel logLevel = vega::LogLevel::INFO,
+            const vega::ConfigurationParameters::TranslationMode translationMode = vega::ConfigurationParameters::BEST_EFFORT);
     virtual ~NastranTokenizer();
 
+    /**
+     * Read and split in advance all the cards of a BULK section file. The cards are then replayed by nextLine().
+     * It does not depend on any model: it can be run on a worker thread.
+     */
+    void preloadBulkSection();
+
+    /**
+     * Return the remaining raw lines which begin with the keyword (case insensitive).
+     * Only available for mapped files: otherwise it returns an empty vector.
+     */
+    std::vector<std::string> findRawLines(const std::string& keyword) const;
+
     /**
      * Set the Tokenizer into BULK mode, which allows three formats: free,
      * short and long.
@@ -131,6 +190,18 @@ public:
     double nextDouble(bool returnDefaultIfNotFoundOrBlank = false, double defaultValue =
             UNAVAILABLE_DOUBLE);
 
+    /**
+     * Decode a Nastran integer field, without any allocation nor exception.
+     * @return false if the field is not a valid integer.
+     */
+    static bool decodeInt(const boost::string_ref& field, int& value);
+    /**
+     * Decode a Nastran real field, without any allocation nor exception.
+     * Accepts E or D exponents and implicit exponents (1.5-3 is 1.5E-3). Blanks inside the field are ignored.
+     * @return false if the field is not a valid real.
+     */
+    static bool decodeDouble(const boost::string_ref& field, double& value);
+
     /**
      * Skip at most n fields. It stops if end of line is reached.
      * @param fieldNum
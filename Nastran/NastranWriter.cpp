@@ -10,7 +10,10 @@
 
 #include "build_properties.h"
 #include "../Abstract/Model.h"
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <memory>
@@ -21,7 +24,6 @@
 #include <ciso646>
 #include "NastranWriter.h"
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/format.hpp>
 
 namespace fs = boost::filesystem;
 using namespace std;
@@ -30,18 +32,8 @@ namespace vega {
 namespace nastran {
 
 ostream &operator<<(ostream &out, const Line& line) {
-	out << left << setw(8);
-	out << line.keyword;
-	int fieldCount = 0;
-	for(const auto& field : line.fields) {
-		fieldCount++;
-		if (fieldCount % line.fieldNum == 0) {
-			out << endl;
-			out << setw(line.fieldLength) << "";
-		}
-		out << field;
-	}
-	out << endl;
+	out.write(line.card.data(), static_cast<streamsize>(line.card.size()));
+	out.put('\n');
 	return out;
 }
 
@@ -53,50 +45,114 @@ Line::Line(string _keyword) : keyword(_keyword) {
 		fieldLength = 8;
 		fieldNum = 8;
 	}
+	card.reserve(8 + fieldNum * fieldLength);
+	card.append(keyword);
+	if (card.size() < 8) {
+		card.append(8 - card.size(), ' ');
+	}
+}
+
+char* Line::nextField() {
+	if (fieldCount > 0 && fieldCount % fieldNum == 0) {
+		// Free field continuation: blank field 10, then the continuation marker in field 1
+		card.append(fieldLength == 16 ? "\n*       " : "\n        ");
+	}
+	fieldCount++;
+	const size_t start = card.size();
+	card.append(fieldLength, ' ');
+	return &card[start];
+}
+
+void Line::addText(const char* text, size_t length) {
+	if (length > fieldLength) {
+		throw invalid_argument(
+				"Value " + string(text, length) + " does not fit in a field of " + keyword);
+	}
+	char* field = nextField();
+	memcpy(field + fieldLength - length, text, length);
+}
+
+size_t Line::formatReal(double value, unsigned int width, char* text) {
+	if (!std::isfinite(value)) {
+		throw invalid_argument("Can't write the real " + to_string(value) + " in a Nastran field.");
+	}
+	if (std::fpclassify(value) == FP_ZERO) {
+		memcpy(text, "0.", 2);
+		return 2;
+	}
+	char formatted[32];
+	char compact[32];
+	// %g gives the shortest notation for a number of significant digits, which is then compacted.
+	// More than 17 digits are meaningless for a double.
+	for (int precision = min(static_cast<int>(width) - 1, 17); precision > 0; precision--) {
+		snprintf(formatted, sizeof(formatted), "%.*g", precision, value);
+		const char* c = formatted;
+		size_t length = 0;
+		if (*c == '-') {
+			compact[length++] = *c++;
+		}
+		if (c[0] == '0' && c[1] == '.') {
+			c++;
+		}
+		bool hasPoint = false;
+		for (; *c != '\0' && *c != 'e'; c++) {
+			hasPoint = hasPoint || *c == '.';
+			compact[length++] = *c;
+		}
+		if (!hasPoint) {
+			compact[length++] = '.';
+		}
+		if (*c == 'e') {
+			c++;
+			compact[length++] = *c++;
+			while (*c == '0' && c[1] != '\0') {
+				c++;
+			}
+			while (*c != '\0') {
+				compact[length++] = *c++;
+			}
+		}
+		if (length <= width) {
+			memcpy(text, compact, length);
+			return length;
+		}
+	}
+	throw invalid_argument("Can't write the real " + to_string(value) + " in a Nastran field.");
 }
 
 Line& Line::add() {
-	this->add(string());
+	nextField();
 	return *this;
 }
 
 Line& Line::add(double value) {
-	std::ostringstream strs;
-	strs << boost::format("%8.7g") % value;
-	string gnum = strs.str();
-	strs.str("");
-	strs.clear();
-	if (gnum.length() <= fieldLength) {
-		strs << internal << setw(this->fieldLength) << gnum;
-	} else {
-		strs << internal << setw(this->fieldLength) << boost::format("%4.2e") % value;
-	}
-	this->fields.push_back(strs.str());
+	char text[32];
+	const size_t length = formatReal(value, fieldLength, text);
+	addText(text, length);
 	return *this;
 }
 
 Line& Line::add(string value) {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	addText(value.data(), value.size());
 	return *this;
 }
 
 Line& Line::add(int value) {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	char digits[INTEGER_TEXT_SIZE];
+	char* end = digits + sizeof(digits);
+	const char* begin = formatInteger(value, end);
+	addText(begin, static_cast<size_t>(end - begin));
 	return *this;
 }
 
-Line& Line::add(const vector<double> values) {
+Line& Line::add(const vector<double>& values) {
 	for(double value : values) {
 		this->add(value);
 	}
 	return *this;
 }
 
-Line& Line::add(const vector<int> values) {
+Line& Line::add(const vector<int>& values) {
 	for(int value : values) {
 		this->add(value);
 	}
@@ -180,13 +236,14 @@ void NastranWriterImpl::writeCells(const shared_ptr<vega::Model>& model, ofstrea
 			continue;
 		}
 		CellGroup* cellGroup = elementSet->cellGroup;
-		for (const Cell& cell : cellGroup->getCells()) {
+		for (int cellPosition : cellGroup->cellPositions()) {
+			const CellView cell = model->mesh->findCellView(cellPosition);
 			string keyword;
 			if (elementSet->isBeam()) {
 				keyword = "CBEAM";
 			} else
 			if (elementSet->isShell()) {
-				switch (cell.type.code) {
+				switch (cell.type().code) {
 				case CellType::TRI3_CODE:
 					keyword = "CTRIA3";
 					break;
@@ -204,7 +261,7 @@ void NastranWriterImpl::writeCells(const shared_ptr<vega::Model>& model, ofstrea
 				}
 			} else
 			if (elementSet->type == ElementSet::CONTINUUM) {
-				switch (cell.type.code) {
+				switch (cell.type().code) {
 				case CellType::HEXA8_CODE:
 					case CellType::HEXA20_CODE:
 					keyword = "CHEXA";
@@ -218,19 +275,28 @@ void NastranWriterImpl::writeCells(const shared_ptr<vega::Model>& model, ofstrea
 				}
 			}
 
-			out << Line(keyword).add(cell.id).add(elementSet->bestId()).add(cell.nodeIds);
+			Line line(keyword);
+			line.add(cell.id()).add(elementSet->bestId());
+			for (size_t i = 0; i < cell.numNodes(); i++) {
+				line.add(cell.nodeId(i));
+			}
+			out << line;
 		}
 	}
 }
 
 void NastranWriterImpl::writeNodes(const shared_ptr<vega::Model>& model, ofstream& out)
 		{
-	for (Node node : model->mesh->nodes) {
-	    if (node.positionCS!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
+	const vector<NodeData>& nodeDatas = model->mesh->nodes.getNodeDatas();
+	const vector<double>& coordinates = model->mesh->nodes.getCoordinates();
+	for (size_t position = 0; position < nodeDatas.size(); position++) {
+		const NodeData& node = nodeDatas[position];
+	    if (node.cpPos!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
 	        cerr << "Warning in GRID "<<node.id<<" CP not supported and dismissed."<<endl;
-        if (node.displacementCS!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
+        if (node.cdPos!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
             cerr << "Warning in GRID "<<node.id<<" CD not supported and dismissed."<<endl;
-		out << Line("GRID").add(node.id).add().add(node.lx).add(node.ly).add(node.lz);
+		out << Line("GRID").add(node.id).add().add(coordinates[3 * position]).add(
+				coordinates[3 * position + 1]).add(coordinates[3 * position + 2]);
 	}
 }
 
@@ -256,6 +322,7 @@ void NastranWriterImpl::writeMaterials(const shared_ptr<vega::Model>& model, ofs
 
 void NastranWriterImpl::writeConstraints(const shared_ptr<vega::Model>& model, ofstream& out)
 		{
+	const vector<NodeData>& nodeDatas = model->mesh->nodes.getNodeDatas();
 	for (const auto& constraintSet : model->constraintSets) {
 		const set<shared_ptr<Constraint> > spcs = constraintSet->getConstraintsByType(
 				Constraint::SPC);
@@ -264,10 +331,10 @@ void NastranWriterImpl::writeConstraints(const shared_ptr<vega::Model>& model, o
 				shared_ptr<const SinglePointConstraint> spc = static_pointer_cast<
 						const SinglePointConstraint>(constraint);
 				for (int nodePosition : spc->nodePositions()) {
-					Node node = model->mesh->findNode(nodePosition);
 					out
 							<< Line("SPC1").add(constraintSet->bestId()).add(
-									spc->getDOFSForNode(nodePosition)).add(node.id);
+									spc->getDOFSForNode(nodePosition)).add(
+									nodeDatas[static_cast<size_t>(nodePosition)].id);
 				}
 			}
 		}
@@ -279,12 +346,10 @@ void NastranWriterImpl::writeConstraints(const shared_ptr<vega::Model>& model, o
 						static_pointer_cast<const RigidConstraint>(constraint);
 				Line rbe2("RBE2");
 				rbe2.add(constraintSet->bestId());
-				Node master = model->mesh->findNode(rigid->getMaster());
-				rbe2.add(master.id);
+				rbe2.add(nodeDatas[static_cast<size_t>(rigid->getMaster())].id);
 				rbe2.add(DOFS::ALL_DOFS);
 				for (int slavePosition : rigid->getSlaves()) {
-					Node slave = model->mesh->findNode(slavePosition);
-					rbe2.add(slave.id);
+					rbe2.add(nodeDatas[static_cast<size_t>(slavePosition)].id);
 				}
 				out << rbe2;
 			}
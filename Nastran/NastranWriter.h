@@ -24,23 +24,45 @@
 namespace vega {
 namespace nastran {
 
+/**
+ * Builds a Nastran card in fixed format: small field (8 characters) or large field
+ * (16 characters) when the keyword ends with '*'.
+ * Fields are formatted straight into the card text, continuation lines included,
+ * so that writing the card is a single write on the stream.
+ */
 class Line {
 private:
 	friend std::ostream &operator<<(std::ostream &out, const Line& line);
 	unsigned int fieldLength = 0;
 	unsigned int fieldNum = 0;
+	unsigned int fieldCount = 0;
 	const string keyword = "";
-	std::vector<string> fields;
+	string card;
+	/**
+	 * Starts a new field of fieldLength characters at the end of the card,
+	 * beginning a continuation line when the current one is full.
+	 */
+	char* nextField();
+	/**
+	 * Right-aligns text of length characters into the next field.
+	 */
+	void addText(const char* text, size_t length);
 public:
 	Line(string _keyword);
 	Line& add();
 	Line& add(double value);
 	Line& add(string value);
 	Line& add(int value);
-	Line& add(const std::vector<int> values);
-	Line& add(const std::vector<double> values);
+	Line& add(const std::vector<int>& values);
+	Line& add(const std::vector<double>& values);
 	Line& add(const DOFS dofs);
 	Line& add(const VectorialValue vector);
+	/**
+	 * Writes value in at most width characters, with as many significant digits as
+	 * possible, using the Nastran real notation: always a decimal point, no
+	 * leading zero, exponent without 'E' (1.2345-6). Returns the length written.
+	 */
+	static size_t formatReal(double value, unsigned int width, char* text);
 };
 
 std::ostream &operator<<(std::ostream &out, const Line& line);
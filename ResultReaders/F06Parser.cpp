@@ -14,12 +14,15 @@
 #if defined VDEBUG && defined __GNUC__
 #include <valgrind/memcheck.h>
 #endif
+#include <array>
+#include <cctype>
 #include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <stdlib.h>
 #include <exception>
+#include <unordered_map>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <ciso646>
@@ -35,24 +38,82 @@ using boost::algorithm::trim;
 using boost::algorithm::trim_copy;
 using boost::lexical_cast;
 
+namespace {
+
+/**
+ * A blank separated field of a line, as a [begin, end) range inside the line.
+ **/
+typedef pair<const char*, const char*> Field;
+
+/**
+ * Splits a line into its blank separated fields without copying them.
+ * Only the first N fields are stored, but all of them are counted so that the
+ * caller can check the number of fields of the line.
+ **/
+template<size_t N>
+size_t splitFields(const string& line, array<Field, N>& fields) {
+	size_t count = 0;
+	const char* c = line.c_str();
+	while (true) {
+		while (*c != '\0' && isspace(static_cast<unsigned char>(*c))) {
+			++c;
+		}
+		if (*c == '\0') {
+			break;
+		}
+		const char* begin = c;
+		while (*c != '\0' && !isspace(static_cast<unsigned char>(*c))) {
+			++c;
+		}
+		if (count < N) {
+			fields[count] = Field(begin, c);
+		}
+		++count;
+	}
+	return count;
+}
+
+int parseInt(const Field& field) {
+	char* end;
+	const long value = strtol(field.first, &end, 10);
+	if (end == field.first) {
+		throw invalid_argument("Invalid integer " + string(field.first, field.second));
+	}
+	return static_cast<int>(value);
+}
+
+double parseDouble(const Field& field) {
+	char* end;
+	const double value = strtod(field.first, &end);
+	if (end == field.first) {
+		throw invalid_argument("Invalid real " + string(field.first, field.second));
+	}
+	return value;
+}
+
+}
+
 F06Parser::F06Parser() {
 	lineNumber = 0;
 }
 
 int F06Parser::readDisplacementSection(const Model& model,
 		const ConfigurationParameters& configuration, ifstream& istream,
-		vector<Assertion*>& assertions, double loadStep) {
+		vector<NodalDisplacement>& displacements) {
 	string header;
 	string currentLine;
 	int subcase_id = NO_SUBCASE;
+	array<Field, 8> fields;
+	unordered_map<int, shared_ptr<CoordinateSystem>> coordSystemByPosition;
 	//skip header line
 	this->readLine(istream, header);
 	try {
 		while (this->readLine(istream, currentLine)) {
-			size_t subCasePosition = currentLine.find("SUBCASE");
 			if (currentLine.find("DIAGNOSTIC TOOLS") != string::npos) {
 				//skip
-			} else if (subCasePosition != string::npos) {
+				continue;
+			}
+			if (currentLine.find("SUBCASE") != string::npos) {
 				/*
 				 * Only used to detect if this section has ended.
 				 * Since the line has been consumed, we will return the (next) subcase
@@ -60,57 +121,59 @@ int F06Parser::readDisplacementSection(const Model& model,
 				 */
 				subcase_id = parseSubcase(subcase_id, currentLine);
 				break;
-			} else if (!isspace(currentLine.at(0))) {
+			}
+			if (!isspace(static_cast<unsigned char>(currentLine[0]))
+					|| splitFields(currentLine, fields) != 8) {
 				//stop parsing the section at the first line that don't start with a space
 				break;
-			} else {
-				istringstream istringLine(currentLine);
-				vector<string> tokens;
-				copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-						back_inserter(tokens));
-				if (tokens.size() != 8)
-					break;
-
-				int nodeId = stoi(tokens[0]);
-				if (tokens[1] != "G"){
-					//cerr << "unsupported assertion type " << assertionType
-					//		<< " : line n." << lineNumber << " " << currentLine
-					//		<< endl;
-					continue;
-				}
-				VectorialValue translation(stod(tokens[2]), stod(tokens[3]), stod(tokens[4]));
-				VectorialValue rotation(stod(tokens[5]), stod(tokens[6]), stod(tokens[7]));
-
-				int nodePosition = model.mesh->findNodePosition(nodeId);
-				Node node = model.mesh->findNode(nodePosition, true, &model);
-				if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
-					Node node = model.mesh->findNode(nodePosition, true, &model);
-					shared_ptr<CoordinateSystem> coordSystem = model.find(
-							Reference<CoordinateSystem>(CoordinateSystem::UNKNOWN,
-									node.displacementCS));
-					coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
-					translation = coordSystem->vectorToGlobal(translation);
-					rotation = coordSystem->vectorToGlobal(rotation);
+			}
+			if (fields[1].second - fields[1].first != 1 || *fields[1].first != 'G') {
+				//unsupported point type
+				continue;
+			}
+			NodalDisplacement displacement;
+			displacement.nodeId = parseInt(fields[0]);
+			for (int i = 0; i < 6; i++) {
+				displacement.values[i] = parseDouble(fields[2 + i]);
+			}
+
+			const int nodePosition = model.mesh->findNodePosition(displacement.nodeId);
+			const Node node = model.mesh->findNode(nodePosition);
+			if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+				shared_ptr<CoordinateSystem>& coordSystem = coordSystemByPosition[node.displacementCS];
+				if (coordSystem == nullptr) {
+					coordSystem = model.getCoordinateSystemByPosition(node.displacementCS);
+					if (coordSystem == nullptr) {
+						throw invalid_argument(
+								"Displacement coordinate system of node "
+										+ to_string(displacement.nodeId) + " not found.");
+					}
 				}
-				double values[6] = {
+				const Node globalNode = model.mesh->findNode(nodePosition, true, &model);
+				coordSystem->updateLocalBase(VectorialValue(globalNode.x, globalNode.y, globalNode.z));
+				const VectorialValue translation = coordSystem->vectorToGlobal(
+						VectorialValue(displacement.values[0], displacement.values[1],
+								displacement.values[2]));
+				const VectorialValue rotation = coordSystem->vectorToGlobal(
+						VectorialValue(displacement.values[3], displacement.values[4],
+								displacement.values[5]));
+				const double globalValues[6] = {
 						translation.x(), translation.y(), translation.z(),
 						rotation.x(), rotation.y(), rotation.z(),
 				};
-				for (int i = 0; i < 6; i++) {
-					double value = values[i];
-					if (abs(value) < 1e-12)
-						value = 0.;
-					assertions.push_back(new NodalDisplacementAssertion(model, configuration.testTolerance,
-									nodeId, DOF::findByPosition(i), value, loadStep));
-				}
-
+				copy(begin(globalValues), end(globalValues), displacement.values);
+			}
+			for (double& value : displacement.values) {
+				if (abs(value) < 1e-12)
+					value = 0.;
 			}
+			displacements.push_back(displacement);
 		}
 	} catch (const exception &e) {
 		string message("Error ");
 		message += string(e.what()) + " parsing:";
 		message += configuration.resultFile.string();
-		message += " Line number " + lexical_cast<string>(currentLine);
+		message += " Line number " + lexical_cast<string>(lineNumber);
 		message += " Line: " + currentLine;
 		cerr << message << endl;
 		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
@@ -143,15 +206,12 @@ void F06Parser::readEigenvalueSection(const Model& model,
 				return;
 			}
 		}
+		array<Field, 7> fields;
 		while (this->readLine(istream, currentLine)) {
-			istringstream istringLine(currentLine);
-			vector<string> tokens;
-			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-					back_inserter(tokens));
-			if (tokens.size() != 7)
+			if (splitFields(currentLine, fields) != 7)
 				break;
-			int number = stoi(tokens.at(0));
-			double value = stod(tokens.at(4));
+			int number = parseInt(fields[0]);
+			double value = parseDouble(fields[4]);
 			if (abs(value) < 1e-12)
 				value = 0.;
 			assertions.push_back(
@@ -161,7 +221,7 @@ void F06Parser::readEigenvalueSection(const Model& model,
 		string message("Error ");
 		message += string(e.what()) + " parsing:";
 		message += configuration.resultFile.string();
-		message += " Line number " + lexical_cast<string>(currentLine);
+		message += " Line number " + lexical_cast<string>(lineNumber);
 		message += " Line: " + currentLine;
 		cerr << message << endl;
 		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
@@ -176,7 +236,10 @@ int F06Parser::readComplexDisplacementSection(const Model& model,
 		const ConfigurationParameters& configuration, ifstream& istream,
 		vector<Assertion*>& assertions, double frequency) {
 	string currentLine;
+	string nextLine;
 	int subcase_id = NO_SUBCASE;
+	array<Field, 9> fields;
+	array<Field, 6> imagFields;
 	try {
 
 		while (this->readLine(istream, currentLine)) {
@@ -193,28 +256,20 @@ int F06Parser::readComplexDisplacementSection(const Model& model,
 				break;
 			}
 
-			istringstream istringLine(currentLine);
-			vector<string> tokens;
-			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-					back_inserter(tokens));
-			if (tokens.size() != 9)
+			if (splitFields(currentLine, fields) != 9)
 				break;
 
-			this->readLine(istream, currentLine);
-			istringLine.clear();
-			istringLine.str(currentLine);
-			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-					back_inserter(tokens));
-			if (tokens.size() != 15)
+			this->readLine(istream, nextLine);
+			if (splitFields(nextLine, imagFields) != 6)
 				throw exception();
 
-			int nodeId = stoi(tokens[1]);
+			int nodeId = parseInt(fields[1]);
 
 			for (int i = 0; i < 6; i++) {
-				double real = stod(tokens[3 + i]);
+				double real = parseDouble(fields[3 + i]);
 				if (abs(real) < 1e-12)
 					real = 0;
-				double imag = stod(tokens[9 + i]);
+				double imag = parseDouble(imagFields[i]);
 				if (abs(imag) < 1e-12)
 					imag = 0;
 				complex<double> value(real, imag);
@@ -228,7 +283,7 @@ int F06Parser::readComplexDisplacementSection(const Model& model,
 		string message("Error ");
 		message += string(e.what()) + " parsing:";
 		message += configuration.resultFile.string();
-		message += " Line number " + lexical_cast<string>(currentLine);
+		message += " Line number " + lexical_cast<string>(lineNumber);
 		message += " Line: " + currentLine;
 		cerr << message << endl;
 		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
@@ -243,8 +298,8 @@ int F06Parser::readComplexDisplacementSection(const Model& model,
 int F06Parser::addAssertionsToModel(int currentSubcase, double loadStep, Model &model,
 		const ConfigurationParameters& configuration, ifstream& istream) {
 
-	vector<Assertion*> assertions;
-	int nextSubcase = readDisplacementSection(model, configuration, istream, assertions, loadStep);
+	vector<NodalDisplacement> displacements;
+	int nextSubcase = readDisplacementSection(model, configuration, istream, displacements);
 	shared_ptr<Analysis> analysis;
 	if (currentSubcase != NO_SUBCASE) {
 		analysis = model.analyses.find(currentSubcase);
@@ -257,19 +312,22 @@ int F06Parser::addAssertionsToModel(int currentSubcase, double loadStep, Model &
 		// created inside the finish()? GC
 		analysis = *model.analyses.begin();
 	}
-	for (Assertion* assertion : assertions) {
-		if (analysis != nullptr) {
-			model.add(*assertion);
-			analysis->add(assertion->getReference());
-			if (model.configuration.logLevel >= LogLevel::TRACE) {
-				cout << "Adding NodalDisplacementAssertion : " << *assertion << " to subcase: "
-						<< currentSubcase << endl;
+	for (const NodalDisplacement& displacement : displacements) {
+		for (int i = 0; i < 6; i++) {
+			NodalDisplacementAssertion assertion(model, configuration.testTolerance,
+					displacement.nodeId, DOF::findByPosition(i), displacement.values[i], loadStep);
+			if (analysis != nullptr) {
+				model.add(assertion);
+				analysis->add(assertion.getReference());
+				if (model.configuration.logLevel >= LogLevel::TRACE) {
+					cout << "Adding NodalDisplacementAssertion : " << assertion << " to subcase: "
+							<< currentSubcase << endl;
+				}
+			} else if (model.configuration.logLevel >= LogLevel::DEBUG) {
+				cout << "Discarding NodalDisplacementAssertion : " << assertion
+						<< " because subcase id: " << currentSubcase << " was not found." << endl;
 			}
-		} else if (model.configuration.logLevel >= LogLevel::DEBUG) {
-			cout << "Discarding NodalDisplacementAssertion : " << *assertion
-					<< " because subcase id: " << currentSubcase << " was not found." << endl;
 		}
-		delete (assertion);
 	}
 	return nextSubcase;
 }
@@ -358,7 +416,11 @@ int F06Parser::parseSubcase(int currentSubCase, const string& currentLine) {
 void F06Parser::add_assertions(const ConfigurationParameters& configuration,
 		shared_ptr<Model> model) {
 	if (!configuration.resultFile.empty()) {
-		ifstream istream(configuration.resultFile.string());
+		// Result files can be huge, read them through a larger buffer than the default one
+		vector<char> buffer(1 << 20);
+		ifstream istream;
+		istream.rdbuf()->pubsetbuf(buffer.data(), static_cast<streamsize>(buffer.size()));
+		istream.open(configuration.resultFile.string());
 		string currentLine;
 		int currentSubCase = NO_SUBCASE;
 		double loadStep = -1;
@@ -410,11 +472,9 @@ bool F06Parser::readLine(istream &istream, string& line) {
 	bool lineAvailable = false;
 	while (getline(istream, line)) {
 		lineNumber += 1;
-		if (!line.empty()) {
-			if (trim_copy(line).size() > 0) {
-				lineAvailable = true;
-				break;
-			}
+		if (line.find_first_not_of(" \t\r\n\v\f") != string::npos) {
+			lineAvailable = true;
+			break;
 		}
 	}
 	return lineAvailable;
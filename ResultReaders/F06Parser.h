@@ -12,6 +12,7 @@
 #define F06PARSER_H_
 #include "../Abstract/SolverInterfaces.h"
 #include <iostream>
+#include <vector>
 
 namespace vega {
 class Model;
@@ -19,6 +20,14 @@ class Model;
 namespace result {
 class F06Parser: public vega::ResultReader {
 private:
+	/**
+	 * One line of a displacement table: the six displacement components of a node,
+	 * already expressed in the global coordinate system.
+	 **/
+	struct NodalDisplacement {
+		int nodeId;
+		double values[6];
+	};
 	int lineNumber;
 	bool readLine(std::istream &istream, std::string& line);
 	int addAssertionsToModel(int currentSubcase, double loadStep, Model &model,
@@ -28,7 +37,7 @@ private:
 	int addComplexAssertionsToModel(int currentSubCase, double frequency, Model&,
 			const ConfigurationParameters&, std::ifstream&);
 	int readDisplacementSection(const Model& model, const ConfigurationParameters&,
-			std::ifstream& istream, std::vector<Assertion*>& assertions, double loadStep);
+			std::ifstream& istream, std::vector<NodalDisplacement>& displacements);
 	void readEigenvalueSection(const Model&, const ConfigurationParameters&, std::ifstream&,
 			std::vector<Assertion*>&);
 	int readComplexDisplacementSection(const Model&, const ConfigurationParameters&, std::ifstream&,
@@ -24,6 +24,7 @@
  */
 
 #include "SystusAsc.h"
+#include <stdexcept>
 
 
 namespace vega {
@@ -74,8 +75,6 @@ void SystusTable::add(const double value){
 SystusMatrix::SystusMatrix(long unsigned int id, int nbDOFS, int nbNodes ) :
         id(id), nbDOFS(nbDOFS), nbNodes(nbNodes){
     this->size=nbNodes*nbNodes*nbDOFS*nbDOFS;
-    this->values.resize(this->size, 0.0);
-
 }
 
 SystusMatrix::~SystusMatrix(){
@@ -83,10 +82,13 @@ SystusMatrix::~SystusMatrix(){
 
 void SystusMatrix::setValue(int i, int j, int dofi, int dofj, double value){
 
-    int pos = (dofi-1) + nbDOFS*(dofj-1) + nbDOFS*nbDOFS*(i-1)+ nbDOFS*nbDOFS*nbNodes*(j-1);
-    if (pos> this->size)
+    if (i<1 || i>nbNodes || j<1 || j>nbNodes || dofi<1 || dofi>nbDOFS || dofj<1 || dofj>nbDOFS)
         throw std::logic_error("Invalid access to Systus Matrix.");
-    this->values[pos]=value;
+    const long unsigned int block = static_cast<long unsigned int>((i-1) + nbNodes*(j-1));
+    std::vector<double>& values = this->blocks[block];
+    if (values.empty())
+        values.resize(static_cast<size_t>(nbDOFS*nbDOFS), 0.0);
+    values[static_cast<size_t>((dofi-1) + nbDOFS*(dofj-1))]=value;
 }
 
 // A lot of fields are filled with 0, because we don't know what to put here
@@ -107,15 +109,22 @@ std::ostream& operator<<(std::ostream& os, const SystusMatrix & sm)
       os << i <<std::endl;
 
   // Matrix elements. All dofs of SM(i,j) are written in one line
-  long unsigned int ioff=0;
-  long unsigned int sizeM = sm.nbDOFS*sm.nbDOFS;
-  for (int i=0; i<sm.nbNodes; i++){
-      for (int j=0; j<sm.nbNodes; j++){
-          for (long unsigned int k=0; k<sizeM; k++){
-              os << sm.values[k +ioff]<<" ";
+  // Lines of the null blocks are all the same: they are only formatted once.
+  std::string zeroLine;
+  for (int k=0; k<sm.nbDOFS*sm.nbDOFS; k++)
+      zeroLine += "0 ";
+  zeroLine += "\n";
+  const long unsigned int nbBlocks = static_cast<long unsigned int>(sm.nbNodes*sm.nbNodes);
+  auto it = sm.blocks.begin();
+  for (long unsigned int block=0; block<nbBlocks; block++){
+      if (it != sm.blocks.end() && it->first == block){
+          for (const double value : it->second){
+              os << value <<" ";
           }
-          os << std::endl;
-          ioff+= sizeM;
+          os << "\n";
+          ++it;
+      }else{
+          os << zeroLine;
       }
   }
 
@@ -123,7 +132,6 @@ std::ostream& operator<<(std::ostream& os, const SystusMatrix & sm)
   return os;
 }
 
-
 // Start of SystusMatrices
 
 SystusMatrices::SystusMatrices(){
@@ -133,7 +141,7 @@ SystusMatrices::~SystusMatrices(){
 }
 
 void SystusMatrices::add(SystusMatrix sm){
-    this->matrices.push_back(sm);
+    this->matrices.push_back(std::move(sm));
 }
 
 void SystusMatrices::clear(){
@@ -68,6 +68,7 @@ public:
 
 /**
  * Modelizes a Systus Matrix (stiffness or mass). They are used by elements X9XX type 0.
+ * Only the non-zero node blocks SM(i,j) are stored.
  */
 class SystusMatrix{
 public:
@@ -76,14 +77,18 @@ public:
     int nbDOFS;			  
     int nbNodes;
     int size;
-    std::vector<double> values;
+    /**
+     * Non-zero blocks, by block number (i-1)+nbNodes*(j-1), i.e in the order of the ASCII file.
+     * Each block holds the nbDOFS*nbDOFS values of SM(i,j), at position (dofi-1)+nbDOFS*(dofj-1).
+     **/
+    std::map<long unsigned int, std::vector<double>> blocks;
 
-    SystusMatrix(long unsigned int id, int nbNodes, int nbDOFS);
+    SystusMatrix(long unsigned int id, int nbDOFS, int nbNodes);
     virtual ~SystusMatrix();
 
     void setValue(int i, int j, int dofi, int dofj, double value);
     /**
-     * Print a SystusMatrix to the output stream.
+     * Print a SystusMatrix to the output stream, in the dense ASCII format.
      */
     friend std::ostream &operator<<(std::ostream &out, const SystusMatrix& sm);
 
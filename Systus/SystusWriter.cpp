@@ -28,6 +28,9 @@
 #include <memory>
 #include <string>
 #include <fstream>
+#include <deque>
+#include <future>
+#include <thread>
 #include <boost/filesystem.hpp>
 #include "SystusWriter.h"
 #include "SystusAsc.h"
@@ -55,7 +58,8 @@ SMF DOFtoSMF(DOF dof){
 }
 
 
-SystusWriter::SystusWriter() {
+SystusWriter::SystusWriter(bool sharedAscSections) :
+        sharedAscSections(sharedAscSections) {
 }
 
 SystusWriter::~SystusWriter() {
@@ -160,17 +164,14 @@ int SystusWriter::DOFToInt(const DOF dof) const{
 
 
 // TODO: That should not be in the Writer.
-CartesianCoordinateSystem SystusWriter::buildElementDefaultReferentiel(const SystusModel& systusModel, const vector<int> nodes, const int dim,
-        const int celltype){
-
-    VectorialValue O,x,y;
+void SystusWriter::buildElementDefaultReferentiel(const SystusModel& systusModel, const vector<int> nodes, const int dim,
+        const int celltype, VectorialValue& x, VectorialValue& y){
 
     switch (dim){
     case 0:
     case 3:{
         x = VectorialValue::X;
         y = VectorialValue::Y;
-        O = VectorialValue(0,0,0);
         break;
     }
 
@@ -179,13 +180,11 @@ CartesianCoordinateSystem SystusWriter::buildElementDefaultReferentiel(const Sys
         if (celltype==6){
             x = VectorialValue::X;
             y = VectorialValue::Y;
-            O = VectorialValue(0,0,0);
         // Other 1D elements are computed from the orientation of the "bar"
         }else{
             shared_ptr<Mesh> mesh = systusModel.model->mesh;
             Node nO = mesh->findNode(mesh->findNodePosition(nodes[0]), true, systusModel.model);
             Node nX = mesh->findNode(mesh->findNodePosition(nodes[1]), true, systusModel.model);
-            O = VectorialValue(nO.x, nO.y, nO.z);
             x = VectorialValue(nX.x-nO.x, nX.y-nO.y, nX.z-nO.z);
             // If the beam is parallel to Oz, we have a special treatment.
             if (is_zero(x.x()) && is_zero(x.y())){
@@ -204,16 +203,7 @@ CartesianCoordinateSystem SystusWriter::buildElementDefaultReferentiel(const Sys
 
     case 2:{
         shared_ptr<Mesh> mesh = systusModel.model->mesh;
-
-        // The origin of the referentiel is the center of the element.
-        O = VectorialValue(0,0,0);
-        int nbnodes=0;
-        for (auto n : nodes){
-            Node node = mesh->findNode(mesh->findNodePosition(n), true, systusModel.model);
-            O = O + VectorialValue(node.x, node.y, node.z);
-            nbnodes++;
-        }
-        O = O/nbnodes;
+        const size_t nbnodes = nodes.size();
 
         // Shell must have at least 3 nodes.
         if (nbnodes<3){
@@ -266,19 +256,11 @@ CartesianCoordinateSystem SystusWriter::buildElementDefaultReferentiel(const Sys
         handleWritingError("Invalid dimension: "+ to_string(dim), "Element Default Referentiel");
         x = VectorialValue::X;
         y = VectorialValue::Y;
-        O = VectorialValue(0,0,0);
     }
     }
-
-    CartesianCoordinateSystem rcs = CartesianCoordinateSystem(*(systusModel.model), O, x, y);
-    rcs.build();
-    return rcs;
-
 }
 
-int SystusWriter::auto_part_id = 99999999;
-
-int SystusWriter::getPartId(const string partName, set<int> & usedPartId) {
+int SystusWriter::getPartId(const string partName, set<int> & usedPartId, int& autoPartId) {
 
     int partId;
 
@@ -288,15 +270,15 @@ int SystusWriter::getPartId(const string partName, set<int> & usedPartId) {
         try{
             partId = std::stoi(partName.substr(pos+1));
         }catch(...){
-            partId = auto_part_id--;
+            partId = autoPartId--;
         }
     }else{
-        partId = auto_part_id--;
+        partId = autoPartId--;
     }
 
     // If the Part Id is unavailable, we find another one.
     while (usedPartId.find(partId)!= usedPartId.end()){
-        partId = auto_part_id--;
+        partId = autoPartId--;
     }
 
     usedPartId.insert(partId);
@@ -393,44 +375,55 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
     getSystusInformations(systusModel, configuration);
     generateRBEs(systusModel, configuration);
     generateSubcases(systusModel, configuration);
-
+    // Nodes and local bases are written with their global coordinates: transform them
+    // all at once, now that the RBEs have added their nodes.
+    model->mesh->buildGlobalCoordinates(*model);
+    // Node groups are read by the concurrent subcase writers
+    model->mesh->sortNodeGroups();
+    fillPartIds(systusModel);
+
+    /* Subcases are translated one after the other, as translation updates some
+     * shared objects (local bases). Once translated, a subcase only reads
+     * the model: its files are written by worker threads, in a private copy of the writer. */
+    const size_t workers = max(1u, thread::hardware_concurrency());
+    deque<future<void>> pendingSubcases;
+    shared_ptr<SystusWriter> subcaseWriter = make_shared<SystusWriter>(*this);
     for (unsigned idSubcase = 0; idSubcase< systusSubcases.size(); idSubcase++){
 
         /* Translation and filling of a lots of things */
-        this->translate(systusModel, idSubcase);
-
-        /* ASCI file */
-        string asc_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1)+ "_DATA1.ASC");
-        ofstream asc_file_ofs;
-        asc_file_ofs.precision(DBL_DIG);
-        asc_file_ofs.open(asc_path.c_str(), ios::trunc | ios::out);
-        if (!asc_file_ofs.is_open()) {
-            string message = string("Can't open file ") + asc_path + " for writing.";
-            throw ios::failure(message);
+        const shared_ptr<SystusWriter> previousWriter = subcaseWriter;
+        subcaseWriter = make_shared<SystusWriter>(*subcaseWriter);
+        subcaseWriter->translate(systusModel, idSubcase);
+        if (sharedAscSections) {
+            subcaseWriter->shareAscSections(*previousWriter);
         }
-        this->writeAsc(systusModel, configuration, idSubcase, asc_file_ofs);
-        asc_file_ofs.close();
-
-        /* Write some matrix files, if needed */
-        this->writeMatrixFiles(systusModel, idSubcase);
-
-        /* Analysis file */
-        ofstream analyse_file_ofs;
-        analyse_file_ofs.precision(DBL_DIG);
-        string analyse_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + ".DAT");
-        analyse_file_ofs.open(analyse_path.c_str(), ios::trunc);
 
-        if (!analyse_file_ofs.is_open()) {
-            string message = string("Can't open file ") + analyse_path + " for writing.";
-            throw ios::failure(message);
+        if (pendingSubcases.size() >= workers) {
+            pendingSubcases.front().get();
+            pendingSubcases.pop_front();
         }
-        this->writeDat(systusModel, configuration, idSubcase, analyse_file_ofs);
-        analyse_file_ofs.close();
+        pendingSubcases.push_back(async(launch::async,
+                [subcaseWriter, &systusModel, &configuration, idSubcase]() {
+            subcaseWriter->writeSubcase(systusModel, configuration, idSubcase);
+        }));
 
         if (configuration.systusOutputProduct=="systus"){
             dat_file_ofs << "READ " << systusModel.getName() << "_SC" << to_string(idSubcase+1) << ".DAT" << endl;
         }
     }
+    // Waits for all subcases before rethrowing the first error, if any.
+    exception_ptr subcaseError;
+    for (auto& pendingSubcase : pendingSubcases) {
+        try {
+            pendingSubcase.get();
+        } catch (...) {
+            if (!subcaseError)
+                subcaseError = current_exception();
+        }
+    }
+    if (subcaseError) {
+        rethrow_exception(subcaseError);
+    }
 
     if (configuration.systusOutputProduct=="systus"){
         dat_file_ofs.close();
@@ -438,6 +431,38 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
     return dat_path;
 }
 
+void SystusWriter::writeSubcase(const SystusModel& systusModel, const ConfigurationParameters& configuration,
+        const int idSubcase) {
+
+    /* ASCI file */
+    string asc_path = getAscFileName(systusModel, idSubcase);
+    ofstream asc_file_ofs;
+    asc_file_ofs.precision(DBL_DIG);
+    asc_file_ofs.open(asc_path.c_str(), ios::trunc | ios::out);
+    if (!asc_file_ofs.is_open()) {
+        string message = string("Can't open file ") + asc_path + " for writing.";
+        throw ios::failure(message);
+    }
+    this->writeAsc(systusModel, configuration, idSubcase, asc_file_ofs);
+    asc_file_ofs.close();
+
+    /* Write some matrix files, if needed */
+    this->writeMatrixFiles(systusModel, idSubcase);
+
+    /* Analysis file */
+    ofstream analyse_file_ofs;
+    analyse_file_ofs.precision(DBL_DIG);
+    string analyse_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + ".DAT");
+    analyse_file_ofs.open(analyse_path.c_str(), ios::trunc);
+
+    if (!analyse_file_ofs.is_open()) {
+        string message = string("Can't open file ") + analyse_path + " for writing.";
+        throw ios::failure(message);
+    }
+    this->writeDat(systusModel, configuration, idSubcase, analyse_file_ofs);
+    analyse_file_ofs.close();
+}
+
 void SystusWriter::getSystusInformations(const SystusModel& systusModel, const ConfigurationParameters& configurationParameters) {
 
     CellType cellType[21] = { CellType::POINT1, CellType::SEG2, CellType::SEG3, CellType::SEG4, CellType::SEG5,
@@ -1556,8 +1581,8 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 // Building the table
                 for (const auto np : sm->nodePairs()){
                     int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = sm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFMatrix& dM = sm->findSubmatrix(np.first, np.second);
+                    for (const auto& dof : dM){
                         int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(dof.second);
@@ -1583,8 +1608,8 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 // Building the table
                 for (const auto np : mm->nodePairs()){
                     int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = mm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFMatrix& dM = mm->findSubmatrix(np.first, np.second);
+                    for (const auto& dof : dM){
                         int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(dof.second);
@@ -1610,8 +1635,8 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 // Building the table
                 for (const auto np : dm->nodePairs()){
                     int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = dm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFMatrix& dM = dm->findSubmatrix(np.first, np.second);
+                    for (const auto& dof : dM){
                         int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(dof.second);
@@ -1802,8 +1827,8 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 for (const auto np : dam->nodePairs()){
                     int nI = positionToSytusNumber[np.first];
                     int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = dam->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFMatrix& dM = dam->findSubmatrix(np.first, np.second);
+                    for (const auto& dof : dM){
                         int dofI = DOFToInt(dof.first.first);
                         int dofJ = DOFToInt(dof.first.second);
                         aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
@@ -1834,8 +1859,8 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 for (const auto np : mm->nodePairs()){
                     int nI = positionToSytusNumber[np.first];
                     int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = mm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFMatrix& dM = mm->findSubmatrix(np.first, np.second);
+                    for (const auto& dof : dM){
                         int dofI = DOFToInt(dof.first.first);
                         int dofJ = DOFToInt(dof.first.second);
                         aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
@@ -1866,8 +1891,8 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 for (const auto np : sm->nodePairs()){
                     int nI = positionToSytusNumber[np.first];
                     int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = sm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFMatrix& dM = sm->findSubmatrix(np.first, np.second);
+                    for (const auto& dof : dM){
                         int dofI = DOFToInt(dof.first.first);
                         int dofJ = DOFToInt(dof.first.second);
                         aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
@@ -1943,9 +1968,138 @@ void SystusWriter::translate(const SystusModel &systusModel, const int idSubcase
     fillLists(systusModel, idSubcase);
 
     fillTables(systusModel, idSubcase);
+
+    fillMatrixFileNames(systusModel, idSubcase);
+}
+
+void SystusWriter::fillMatrixFileNames(const SystusModel& systusModel, const int idSubcase){
+    if (dampingMatrices.size()>0){
+        filebyAccessId[SystusWriter::DampingAccessId]= systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_DAMGEN";
+    }
+    if (massMatrices.size()>0){
+        filebyAccessId[SystusWriter::MassAccessId]= systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_MASGEN";
+    }
+    if (stiffnessMatrices.size()>0){
+        filebyAccessId[SystusWriter::StiffnessAccessId]=systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_STIGEN";
+    }
 }
 
+bool SystusWriter::isPartGroup(const CellGroup& cellGroup){
+    // We don't write the groups of Nodal Mass, as they are not cells in Systus
+    // We don't write the Orientation groups, they are not parts.
+    // It IS an Ugly Fix. I know it is.
+    // TODO: DO better
+    return (cellGroup.getComment().substr(0,10)!="NODAL MASS")&&
+            (cellGroup.getComment()!="Orientation");
+}
 
+void SystusWriter::fillPartIds(const SystusModel& systusModel){
+    partIdByCellGroupName.clear();
+    set<int> pids= {};
+    int autoPartId = 99999999;
+    for (const auto& cellGroup : systusModel.model->mesh->getCellGroups()) {
+        if (isPartGroup(*cellGroup)){
+            partIdByCellGroupName[cellGroup->getName()] = getPartId(cellGroup->getName(), pids, autoPartId);
+        }
+    }
+}
+
+
+
+bool SystusAscSection::claim() {
+    unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return !writing; });
+    if (written) {
+        return false;
+    }
+    writing = true;
+    return true;
+}
+
+void SystusAscSection::release(const string& path, streamoff begin, streamoff end) {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        this->path = path;
+        this->begin = begin;
+        this->end = end;
+        writing = false;
+        written = true;
+    }
+    changed.notify_all();
+}
+
+void SystusAscSection::abandon() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        writing = false;
+    }
+    changed.notify_all();
+}
+
+void SystusAscSection::copyTo(ostream& out) const {
+    ifstream in(path.c_str(), ios::in | ios::binary);
+    in.seekg(begin);
+    vector<char> block(1 << 20);
+    streamoff left = end - begin;
+    while (left > 0 && in) {
+        const streamsize size = static_cast<streamsize>(min(left, static_cast<streamoff>(block.size())));
+        in.read(block.data(), size);
+        out.write(block.data(), in.gcount());
+        left -= in.gcount();
+    }
+    if (left > 0) {
+        throw ios::failure("Can't copy a section of the file " + path + ".");
+    }
+}
+
+void SystusWriter::shareAscSections(const SystusWriter& previous) {
+    // Node lines carry the constraints, local bases and lists of the subcase
+    if (!nodeSection || constraintByNodePosition != previous.constraintByNodePosition
+            || localVectorIdByNodePosition != previous.localVectorIdByNodePosition
+            || loadingListIdByNodePosition != previous.loadingListIdByNodePosition
+            || constraintListIdByNodePosition != previous.constraintListIdByNodePosition) {
+        nodeSection = make_shared<SystusAscSection>();
+    }
+    // Element lines only depend on the model
+    if (!elementSection) {
+        elementSection = make_shared<SystusAscSection>();
+    }
+    // Part Ids are chosen once for all subcases
+    if (!groupSection) {
+        groupSection = make_shared<SystusAscSection>();
+    }
+}
+
+void SystusWriter::writeAscSection(const shared_ptr<SystusAscSection>& section,
+        void (SystusWriter::*writeSection)(const SystusModel&, ostream&),
+        const SystusModel& systusModel, const string& ascPath, ostream& out) {
+    if (!section) {
+        (this->*writeSection)(systusModel, out);
+        return;
+    }
+    if (!section->claim()) {
+        section->copyTo(out);
+        return;
+    }
+    // Written straight to the file, which the other subcases then read back
+    const streamoff begin = out.tellp();
+    try {
+        (this->*writeSection)(systusModel, out);
+        out.flush();
+    } catch (...) {
+        section->abandon();
+        throw;
+    }
+    if (out) {
+        section->release(ascPath, begin, out.tellp());
+    } else {
+        section->abandon();
+    }
+}
+
+string SystusWriter::getAscFileName(const SystusModel& systusModel, const int idSubcase) const {
+    return systusModel.getOutputFileName("_SC" + to_string(idSubcase+1)+ "_DATA1.ASC");
+}
 
 void SystusWriter::writeAsc(const SystusModel &systusModel, const vega::ConfigurationParameters &configuration,
         const int idSubcase, ostream& out) {
@@ -1954,11 +2108,12 @@ void SystusWriter::writeAsc(const SystusModel &systusModel, const vega::Configur
 
     writeInformations(systusModel, idSubcase, out);
 
-    writeNodes(systusModel, out);
+    const string ascPath = getAscFileName(systusModel, idSubcase);
+    writeAscSection(nodeSection, &SystusWriter::writeNodes, systusModel, ascPath, out);
 
-    writeElements(systusModel, out);
+    writeAscSection(elementSection, &SystusWriter::writeElements, systusModel, ascPath, out);
 
-    writeGroups(systusModel, out);
+    writeAscSection(groupSection, &SystusWriter::writeGroups, systusModel, ascPath, out);
 
     writeMaterials(systusModel, configuration, out);
 
@@ -2080,6 +2235,23 @@ void SystusWriter::writeInformations(const SystusModel &systusModel, int idSubca
     out << "END_INFORMATIONS" << endl;
 }
 
+namespace {
+
+/**
+ * Value of a map keyed by node position, for increasing positions: the iterator
+ * only moves forward, so that a sweep over all the nodes reads the map once.
+ */
+template<typename T>
+T valueAtPosition(const map<int, T>& byPosition, typename map<int, T>::const_iterator& it,
+        int position) {
+    while (it != byPosition.end() && it->first < position) {
+        ++it;
+    }
+    return (it != byPosition.end() && it->first == position) ? it->second : T();
+}
+
+}
+
 void SystusWriter::writeNodes(const SystusModel& systusModel, ostream& out) {
     const shared_ptr<Mesh> mesh = systusModel.model->mesh;
 
@@ -2087,35 +2259,40 @@ void SystusWriter::writeNodes(const SystusModel& systusModel, ostream& out) {
     out << mesh->countNodes();
     out << " 3" << endl; // number of coordinates
 
-    for (const auto& node : mesh->nodes) {
-        Node nNode = mesh->findNode(node.position, true, systusModel.model);
-        int nid = nNode.id;
-        int iconst = 0;
-        auto it = constraintByNodePosition.find(node.position);
-        if (it != constraintByNodePosition.end())
-            iconst = int(it->second);
+    const vector<NodeData>& nodeDatas = mesh->nodes.getNodeDatas();
+    const vector<double>& x = mesh->getGlobalCoordinates(*systusModel.model, 0);
+    const vector<double>& y = mesh->getGlobalCoordinates(*systusModel.model, 1);
+    const vector<double>& z = mesh->getGlobalCoordinates(*systusModel.model, 2);
+    auto constraintIt = constraintByNodePosition.cbegin();
+    auto localVectorIt = localVectorIdByNodePosition.cbegin();
+    auto loadingListIt = loadingListIdByNodePosition.cbegin();
+    auto constraintListIt = constraintListIdByNodePosition.cbegin();
+    TextBuffer buffer(out, 1 << 20);
+    for (size_t position = 0; position < nodeDatas.size(); position++) {
+        const int nodePosition = static_cast<int>(position);
+        const NodeData& node = nodeDatas[position];
+        int nid = node.id;
+        int iconst = int(valueAtPosition(constraintByNodePosition, constraintIt, nodePosition));
         int imeca = 0;
-        long unsigned int iangl = 0;
-        if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
-            iangl = localVectorIdByNodePosition[node.position];
-        }
-        int isol = 0;
-        auto it2 = loadingListIdByNodePosition.find(node.position);
-        if (it2 != loadingListIdByNodePosition.end())
-            isol = it2->second;
-        int idisp = 0;
-        it2 = constraintListIdByNodePosition.find(node.position);
-        if (it2 != constraintListIdByNodePosition.end())
-            idisp = it2->second;
-        out << nid << " " << iconst << " " << imeca << " " << iangl << " " << isol << " " << idisp
-                << " ";
-        out << nNode.x << " " << nNode.y << " " << nNode.z << endl;
+        long unsigned int iangl = valueAtPosition(localVectorIdByNodePosition, localVectorIt, nodePosition);
+        if (node.cdPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
+            iangl = 0;
+        }
+        int isol = valueAtPosition(loadingListIdByNodePosition, loadingListIt, nodePosition);
+        int idisp = valueAtPosition(constraintListIdByNodePosition, constraintListIt, nodePosition);
+        buffer.append(static_cast<long long>(nid)).append(' ').append(static_cast<long long>(iconst)).append(
+                ' ').append(static_cast<long long>(imeca)).append(' ').append(
+                static_cast<long long>(iangl)).append(' ').append(static_cast<long long>(isol)).append(
+                ' ').append(static_cast<long long>(idisp)).append(' ');
+        buffer.append(x[position]).append(' ').append(y[position]).append(' ').append(z[position]);
+        buffer.endLine();
 
         // Small warning against "infinite" node.
-        if (nNode.x < -1.0e+300){
+        if (x[position] < -1.0e+300){
             handleWritingWarning("Infinite node with Id: " + std::to_string(nid),"Nodes");
         }
     }
+    buffer.flush();
 
     out << "END_NODES" << endl;
 }
@@ -2137,8 +2314,9 @@ void SystusWriter::writeElementLocalReferentiel(const SystusModel& systusModel,
         return;
     }
     
-    CartesianCoordinateSystem rcs = buildElementDefaultReferentiel(systusModel, nodes, dim, celltype);
-    VectorialValue angles = cs->getEulerAnglesIntrinsicZYX(&rcs); // (PSI, THETA, PHI)
+    VectorialValue rx, ry;
+    buildElementDefaultReferentiel(systusModel, nodes, dim, celltype, rx, ry);
+    VectorialValue angles = cs->getEulerAnglesIntrinsicZYX(rx, ry); // (PSI, THETA, PHI)
     
     switch (dim) {
 
@@ -2199,6 +2377,7 @@ void SystusWriter::writeElementLocalReferentiel(const SystusModel& systusModel,
 void SystusWriter::writeElements(const SystusModel& systusModel, ostream& out) {
     shared_ptr<Mesh> mesh = systusModel.model->mesh;
     out << "BEGIN_ELEMENTS " << mesh->countCells() << endl;
+    TextBuffer buffer(out, 1 << 20);
     for (const auto& elementSet : systusModel.model->elementSets) {
 
         CellGroup* cellGroup = elementSet->cellGroup;
@@ -2277,49 +2456,65 @@ void SystusWriter::writeElements(const SystusModel& systusModel, ostream& out) {
             typecell = 0;
         }
         }
-        for (const Cell& cell : cellGroup->getCells()) {
-            auto systus2med_it = systus2medNodeConnectByCellType.find(cell.type.code);
-            if (systus2med_it == systus2medNodeConnectByCellType.end()) {
-                cout << "Warning in Elements: " << cell << " not supported in Systus" << endl;
+        vector<int> systusConnect;
+        CellType::Code lastTypeCode = CellType::POLY3_CODE;
+        const vector<int>* systus2medNodeConnect = nullptr;
+        for (int cellPosition : cellGroup->cellPositions()) {
+            const CellView cell = mesh->findCellView(cellPosition);
+            // Cells of a group are mostly of the same type: look up the remapping only on type changes
+            if (systus2medNodeConnect == nullptr || cell.type().code != lastTypeCode) {
+                auto systus2med_it = systus2medNodeConnectByCellType.find(cell.type().code);
+                systus2medNodeConnect = (systus2med_it == systus2medNodeConnectByCellType.end()) ?
+                        nullptr : &systus2med_it->second;
+                lastTypeCode = cell.type().code;
+            }
+            if (systus2medNodeConnect == nullptr) {
+                buffer.flush();
+                cout << "Warning in Elements: " << mesh->findCell(cellPosition) << " not supported in Systus" << endl;
                 continue;
             }
 
             // Putting all nodes in the Systus order
-            vector<int> systus2medNodeConnect = systus2med_it->second;
-            vector<int> medConnect = cell.nodeIds;
-            vector<int> systusConnect;
-            for (unsigned int i = 0; i < cell.type.numNodes; i++)
-                systusConnect.push_back(medConnect[systus2medNodeConnect[i]]);
+            systusConnect.clear();
+            for (unsigned int i = 0; i < cell.type().numNodes; i++)
+                systusConnect.push_back(cell.nodeId(static_cast<size_t>((*systus2medNodeConnect)[i])));
 
             if (elementSet->type==ElementSet::STRUCTURAL_SEGMENT){
-                dim = (cell.nodeIds.size()==2) ? 1 : 0 ;
+                dim = (cell.numNodes()==2) ? 1 : 0 ;
             }
 
-            out << cell.id << " " << dim << typecell;              // Dimension and type of cell;
-            out << setfill('0') << setw(2) << cell.nodeIds.size(); // Number of nodes in two caracters: 01, 02, 05, 10, etc.
+            // Dimension and type of cell, then number of nodes in two caracters: 01, 02, 05, 10, etc.
+            buffer.append(static_cast<long long>(cell.id())).append(' ').append(static_cast<long long>(dim)).append(
+                    static_cast<long long>(typecell));
+            if (cell.numNodes() < 10) {
+                buffer.append('0');
+            }
+            buffer.append(static_cast<long long>(cell.numNodes()));
 
-            if (cell.nodeIds.size()>20){
-                cerr<< "Warning in Elements: " << cell << " has " << cell.nodeIds.size() << " but SYSTUS only support up to 20 nodes by element."<<endl;
+            if (cell.numNodes()>20){
+                cerr<< "Warning in Elements: " << mesh->findCell(cellPosition) << " has " << cell.numNodes() << " but SYSTUS only support up to 20 nodes by element."<<endl;
             }
 
             //TODO: We should write here the Material Id: we use the elementSet id which SHOULD be the same
-            out << " " << elementSet->getId(); // Material Id (it's an ugly fix)
-            out << " 0"; // Loading List:  index that describes solicitation list (not supported yet)
+            buffer.append(' ').append(static_cast<long long>(elementSet->getId())); // Material Id (it's an ugly fix)
+            buffer.append(' ').append(0ll); // Loading List:  index that describes solicitation list (not supported yet)
 
             // Local Orientation
-            if (cell.hasOrientation){
-                writeElementLocalReferentiel(systusModel, dim, typecell, systusConnect, cell.cid, out);
+            if (cell.hasOrientation()){
+                buffer.flush();
+                writeElementLocalReferentiel(systusModel, dim, typecell, systusConnect, cell.cid(), out);
             }else{
-                out << " 0";
-            } 
+                buffer.append(' ').append(0ll);
+            }
 
             // Writing Nodes
             for (int node : systusConnect) {
-                out << " " << node;
+                buffer.append(' ').append(static_cast<long long>(node));
             }
-            out << endl;
+            buffer.endLine();
         }
     }
+    buffer.flush();
 
     out << "END_ELEMENTS" << endl;
 }
@@ -2333,21 +2528,15 @@ void SystusWriter::writeGroups(const SystusModel& systusModel, ostream& out) {
     int nbGroups=0;
 
     // Write CellGroups
-    set<int> pids= {};
     for (const auto& cellGroup : cellGroups) {
-        // We don't write the groups of Nodal Mass, as they are not cells in Systus
-        // We don't write the Orientation groups, they are not parts.
-        // It IS an Ugly Fix. I know it is.
-        // TODO: DO better
-        if ((cellGroup->getComment().substr(0,10)!="NODAL MASS")&&
-                (cellGroup->getComment()!="Orientation")){
+        if (isPartGroup(*cellGroup)){
             nbGroups++;
             osgr << nbGroups << " " << cellGroup->getName() << " 2 0 ";
-            osgr << "\"PART_ID "<< getPartId(cellGroup->getName(), pids) << "\"  \"\"  ";
+            osgr << "\"PART_ID "<< partIdByCellGroupName.at(cellGroup->getName()) << "\"  \"\"  ";
             osgr << "\"PART built in VEGA from "<< cellGroup->getComment() << "\"";
 
-            for (const auto& cell : cellGroup->getCells())
-                osgr << " " << cell.id;
+            for (int cellId : cellGroup->cellIds)
+                osgr << " " << cellId;
             osgr << endl;
         }
     }
@@ -3160,54 +3349,37 @@ void SystusWriter::writeFrequencyAssertion(Assertion& assertion, ostream& out) {
 
 
 
+void SystusWriter::writeMatrixFile(const SystusModel& systusModel, const int idSubcase,
+        const string& suffix, const SystusMatrices& matrices){
+
+    ofstream ofsMatrixFile;
+    ofsMatrixFile.precision(DBL_DIG);
+    string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + suffix + ".ASC");
+    ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
+
+    if (!ofsMatrixFile.is_open()) {
+        string message = string("Can't open file ") + matrixFile + " for writing.";
+        throw ios::failure(message);
+    }
+    ofsMatrixFile << matrices << endl;
+    ofsMatrixFile.close();
+}
+
 void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int idSubcase){
 
     /* Writing Damping Matrices */
     if (dampingMatrices.size()>0){
-        ofstream ofsMatrixFile;
-        ofsMatrixFile.precision(DBL_DIG);
-        string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_DAMGEN.ASC");
-        ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
-
-        if (!ofsMatrixFile.is_open()) {
-            string message = string("Can't open file ") + matrixFile + " for writing.";
-            throw ios::failure(message);
-        }
-        ofsMatrixFile << dampingMatrices<<endl;
-        ofsMatrixFile.close();
-        filebyAccessId[SystusWriter::DampingAccessId]= systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_DAMGEN";
+        writeMatrixFile(systusModel, idSubcase, "_DAMGEN", dampingMatrices);
     }
 
     /* Writing Mass Matrices */
     if (massMatrices.size()>0){
-        ofstream ofsMatrixFile;
-        ofsMatrixFile.precision(DBL_DIG);
-        string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_MASGEN.ASC");
-        ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
-
-        if (!ofsMatrixFile.is_open()) {
-            string message = string("Can't open file ") + matrixFile + " for writing.";
-            throw ios::failure(message);
-        }
-        ofsMatrixFile << massMatrices << endl;
-        ofsMatrixFile.close();
-        filebyAccessId[SystusWriter::MassAccessId]= systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_MASGEN";
+        writeMatrixFile(systusModel, idSubcase, "_MASGEN", massMatrices);
     }
 
     /* Writing Stiffness Matrices */
     if (stiffnessMatrices.size()>0){
-        ofstream ofsMatrixFile;
-        ofsMatrixFile.precision(DBL_DIG);
-        string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_STIGEN.ASC");
-        ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
-
-        if (!ofsMatrixFile.is_open()) {
-            string message = string("Can't open file ") + matrixFile + " for writing.";
-            throw ios::failure(message);
-        }
-        ofsMatrixFile << stiffnessMatrices <<endl;
-        ofsMatrixFile.close();
-        filebyAccessId[SystusWriter::StiffnessAccessId]=systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_STIGEN";
+        writeMatrixFile(systusModel, idSubcase, "_STIGEN", stiffnessMatrices);
     }
 }
 
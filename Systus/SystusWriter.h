@@ -14,6 +14,8 @@
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <string>
 #include <fstream>
 #include <boost/filesystem.hpp>
@@ -88,12 +90,38 @@ static const int defaultNbDesiredRoots=100; /**< Default number of desired roots
 
 static double maxYoungModulus = Globals::UNAVAILABLE_DOUBLE;
 
+/**
+ * A section of the ASC file shared by several subcases, see SystusWriter::shareAscSections().
+ * The first subcase to reach it writes it in its own ASC file, the others copy these bytes.
+ */
+class SystusAscSection final {
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool writing = false;
+    bool written = false;
+    std::string path;           /**< ASC file holding the section, once written. **/
+    std::streamoff begin = 0;   /**< Offset of the section in this file. **/
+    std::streamoff end = 0;     /**< Offset of the end of the section in this file. **/
+public:
+    /**
+     * Returns true if the caller must write the section, then call release() or abandon().
+     * Otherwise, waits until another subcase has written the section, and returns false.
+     */
+    bool claim();
+    /** The section has been written, and flushed, between begin and end of the file path. **/
+    void release(const std::string& path, std::streamoff begin, std::streamoff end);
+    /** The section could not be written: the next subcase to claim it will write it. **/
+    void abandon();
+    /** Copy the written section from its ASC file. **/
+    void copyTo(std::ostream&) const;
+};
+
 class SystusWriter: public Writer {
     int systusOption = 0;
     int systusSubOption = 0;
     int maxNumNodes = 0;
     int nbNodes = 0;						 /**< Useless >**/
-    static int auto_part_id;                 /**< Next available numer for Systus Part ID **/
+    bool sharedAscSections = true;          /**< Write the identical sections of the subcases once, see shareAscSections(). **/
     static const int DampingAccessId;        /**< Access Id for the Damping Matrices file (Element X9XX type 0)**/
     static const int MassAccessId;			 /**< Access Id for the Mass Matrices file (Element X9XX type 0)**/
     static const int StiffnessAccessId;      /**< Access Id for the Stiffness Matrices file (Element X9XX type 0)**/
@@ -120,6 +148,10 @@ class SystusWriter: public Writer {
     map<int, long unsigned int> tableByLoadcase;
     map<int, long unsigned int> seIdByElementSet; /**< Number of the matrix associated to SE (element X9XX type 0). **/
     map<int, std::string > filebyAccessId;        /**< Names of matrix files **/
+    map<std::string, int> partIdByCellGroupName;  /**< Part Id of each written Cell Group, see writeGroups(). **/
+    shared_ptr<SystusAscSection> nodeSection;     /**< Nodes of the ASC file, shared with the previous subcase when identical. **/
+    shared_ptr<SystusAscSection> elementSection;  /**< Elements of the ASC file, shared by all subcases. **/
+    shared_ptr<SystusAscSection> groupSection;    /**< Groups of the ASC file, shared with the previous subcase when identical. **/
     /**
      * Renumbers the nodes
      * see Systus ref manual chapter 15 or chapter 13 2.7
@@ -290,10 +322,26 @@ class SystusWriter: public Writer {
     int DOFToInt(const DOF dof) const;
 
     /** Find an available Part Id for a Cell Group.
-     * If possible, try to use the suffix (_NN) of the Group Name. **/
-    int getPartId(const string partName, std::set<int> & usedPartId);
+     * If possible, try to use the suffix (_NN) of the Group Name,
+     * else use autoPartId, the next available number, counting down. **/
+    int getPartId(const string partName, std::set<int> & usedPartId, int& autoPartId);
     static const std::unordered_map<CellType::Code, vector<int>, hash<int>> systus2medNodeConnectByCellType;
     void writeAsc(const SystusModel&, const ConfigurationParameters&, const int idSubcase, std::ostream&);
+    /**
+     * Geometry sections only depend on the model and on a few translated maps: keep the
+     * sections of the previous subcase whose maps are unchanged, so that they are
+     * formatted once for all these subcases. Must be called after translate().
+     */
+    void shareAscSections(const SystusWriter& previous);
+    /**
+     * Write a section of the ASC file ascPath with writeSection, or copy it from the
+     * ASC file of the subcase which already wrote it.
+     **/
+    void writeAscSection(const shared_ptr<SystusAscSection>& section,
+            void (SystusWriter::*writeSection)(const SystusModel&, std::ostream&),
+            const SystusModel&, const std::string& ascPath, std::ostream&);
+    /** Name of the ASC file of a subcase. **/
+    std::string getAscFileName(const SystusModel&, const int idSubcase) const;
     void getSystusInformations(const SystusModel&, const ConfigurationParameters&);
 
     /** 
@@ -316,6 +364,15 @@ class SystusWriter: public Writer {
     void fillTables(const SystusModel&, const int idSubcase);
     void fillVectors(const SystusModel&, const int idSubcase);
     void fillLists(const SystusModel&, const int idSubcase);
+    /**
+     * Choose the Part Id of every written Cell Group. It is done once for all
+     * subcases, so that their group sections are identical.
+     */
+    void fillPartIds(const SystusModel&);
+    /** Name the matrix files of the subcase, for the ASSIGN commands of the DAT file. **/
+    void fillMatrixFileNames(const SystusModel&, const int idSubcase);
+    /** True if the Cell Group is written as a PART in the ASC file. **/
+    static bool isPartGroup(const CellGroup& cellGroup);
 
     /**
      *  Generate a rigidity for a a Rbar Element Set. The formulation we use is
@@ -353,11 +410,13 @@ class SystusWriter: public Writer {
     void writeNodes(const SystusModel&, std::ostream&);
 
     /**
-     *  Compute the default referentiel for an element, as described in the
+     *  Compute the axes x and y of the default referentiel for an element, as described in the
      *  Systus Reference Manual secion "16.2 Local axes (X,Y,Z)"
+     *  No CoordinateSystem is built, as elements are written by concurrent subcase writers.
      *  TODO: Should not be a part of the writer.
      **/
-    CartesianCoordinateSystem buildElementDefaultReferentiel(const SystusModel& systusModel, const vector<int> nodes, const int dim, const int celltype);
+    void buildElementDefaultReferentiel(const SystusModel& systusModel, const vector<int> nodes, const int dim, const int celltype,
+            VectorialValue& x, VectorialValue& y);
 
     /**
      *  Write the Euler Angles corresponding to an element with local referentiel cpos.
@@ -416,13 +475,26 @@ class SystusWriter: public Writer {
 
     /**
      * Write all matrix files to an ASC format. To be used by SYSTUS, these files must be converted to
-     * a BINARY format (tool filematrix of the ESI Systus Package)
+     * a BINARY format (tool filematrix of the ESI Systus Package).
      */
     void writeMatrixFiles(const SystusModel& systusModel, const int idSubcase);
+    /**
+     * Write one matrix file, in ASCII (.ASC).
+     */
+    void writeMatrixFile(const SystusModel& systusModel, const int idSubcase, const std::string& suffix, const SystusMatrices& matrices);
+
+    /**
+     * Write the ASC, matrix and DAT files of an already translated subcase.
+     * Only reads the model, so translated subcases can be written concurrently.
+     */
+    void writeSubcase(const SystusModel& systusModel, const ConfigurationParameters&, const int idSubcase);
 
 
 public:
-    SystusWriter();
+    /**
+     * If sharedAscSections is false, each subcase formats all the sections of its ASC file.
+     */
+    explicit SystusWriter(bool sharedAscSections = true);
     virtual ~SystusWriter();
 
     string writeModel(const std::shared_ptr<Model> model, const ConfigurationParameters&)
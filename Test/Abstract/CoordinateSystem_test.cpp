@@ -151,3 +151,67 @@ BOOST_AUTO_TEST_CASE( test_CoordinateSystem ) {
     }
 
 }
+
+BOOST_AUTO_TEST_CASE( test_global_coordinates ) {
+    Model model("test");
+    CartesianCoordinateSystem cartesian(model, VectorialValue(1., 2., 3.),
+            VectorialValue(0., 1., 0.), VectorialValue(-1., 0., 0.), 5);
+    CylindricalCoordinateSystem cylindrical(model, VectorialValue(0., 0., 1.), VectorialValue::X,
+            VectorialValue::Y, 6);
+    model.add(cartesian);
+    model.add(cylindrical);
+    const int cartesianPosition = model.findOrReserveCoordinateSystem(5);
+    const int cylindricalPosition = model.findOrReserveCoordinateSystem(6);
+    const int missingPosition = model.findOrReserveCoordinateSystem(7);
+    const int cs[4] = { CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, cartesianPosition,
+            cylindricalPosition, missingPosition };
+    for (int i = 0; i < 40; i++) {
+        model.mesh->addNode(i + 1, 0.5 * i, 9. * i, -0.25 * i, cs[i % 4]);
+    }
+
+    vector<Node> expected;
+    for (int i = 0; i < 40; i++) {
+        expected.push_back(model.mesh->findNode(i, true, &model));
+    }
+    model.mesh->buildGlobalCoordinates(model);
+    for (int i = 0; i < 40; i++) {
+        const Node node = model.mesh->findNode(i, true, &model);
+        // the bulk transform groups the operations as the per node one
+        BOOST_CHECK_EQUAL(node.x, expected[i].x);
+        BOOST_CHECK_EQUAL(node.y, expected[i].y);
+        BOOST_CHECK_EQUAL(node.z, expected[i].z);
+    }
+    const Node cylindricalNode = model.mesh->findNode(2, true, &model);
+    BOOST_CHECK_CLOSE(cylindricalNode.x, cos(M_PI * 18. / 180.), 1e-9);
+    BOOST_CHECK_CLOSE(cylindricalNode.z, 0.5, 1e-9);
+
+    // a new node drops the cached coordinates
+    model.mesh->addNode(41, 1., 2., 3., cartesianPosition);
+    const Node added = model.mesh->findNode(40, true, &model);
+    BOOST_CHECK_CLOSE(added.x, -1., 1e-9);
+    BOOST_CHECK_CLOSE(added.y, 3., 1e-9);
+    BOOST_CHECK_CLOSE(added.z, 6., 1e-9);
+    // and the whole arrays are rebuilt on demand
+    const vector<double>& globalY = model.mesh->getGlobalCoordinates(model, 1);
+    BOOST_REQUIRE_EQUAL(globalY.size(), 41);
+    BOOST_CHECK_EQUAL(globalY[7], expected[7].y);
+    BOOST_CHECK_CLOSE(globalY[40], 3., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( test_euler_angles_from_axes ) {
+    Model model("test");
+    CartesianCoordinateSystem local(model, VectorialValue(0., 0., 0.), VectorialValue(1., 1., 0.5),
+            VectorialValue(-1., 2., 0.));
+    const VectorialValue rx(0.2, 1., -0.3);
+    const VectorialValue ry(1., 0., 0.7);
+    CartesianCoordinateSystem reference(model, VectorialValue(4., 5., 6.), rx, ry);
+    reference.build();
+    const int lastId = Identifiable<CoordinateSystem>::lastAutoId();
+    const VectorialValue angles = local.getEulerAnglesIntrinsicZYX(rx, ry);
+    // no coordinate system built, the very same angles
+    BOOST_CHECK_EQUAL(Identifiable<CoordinateSystem>::lastAutoId(), lastId);
+    const VectorialValue expected = local.getEulerAnglesIntrinsicZYX(&reference);
+    BOOST_CHECK_EQUAL(angles.x(), expected.x());
+    BOOST_CHECK_EQUAL(angles.y(), expected.y());
+    BOOST_CHECK_EQUAL(angles.z(), expected.z());
+}
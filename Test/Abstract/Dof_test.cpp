@@ -85,3 +85,37 @@ BOOST_AUTO_TEST_CASE( test_differentnodes ) {
 	BOOST_CHECK(is_equal(found, expected));
 	BOOST_CHECK(!matrix.isDiagonal());
 }
+
+BOOST_AUTO_TEST_CASE( test_dofmatrix_components ) {
+	DOFMatrix matrix(true);
+	BOOST_CHECK(matrix.isEmpty());
+	BOOST_CHECK(matrix.begin() == matrix.end());
+	matrix.addComponent(DOF::RZ, DOF::DY, 2.0);
+	matrix.addComponent(DOF::DX, DOF::DX, 1.0);
+	BOOST_CHECK_EQUAL(matrix.size(), 2u);
+	// Symmetric matrix: only the upper triangle is stored
+	BOOST_CHECK(matrix.hasComponent(DOF::DY, DOF::RZ));
+	BOOST_CHECK(!matrix.hasComponent(DOF::RZ, DOF::DY));
+	BOOST_CHECK(is_equal(matrix.findComponent(DOF::RZ, DOF::DY), 2.0));
+	BOOST_CHECK(is_equal(matrix.getComponent(DOF::RZ, DOF::DY), 0.0));
+	BOOST_CHECK(matrix.hasRotations());
+	BOOST_CHECK(matrix.hasTranslations());
+
+	// Iteration by row then column DOF
+	auto it = matrix.begin();
+	BOOST_CHECK((*it).first.first == DOF::DX);
+	BOOST_CHECK((*it).first.second == DOF::DX);
+	BOOST_CHECK(is_equal((*it).second, 1.0));
+	++it;
+	BOOST_CHECK((*it).first.first == DOF::DY);
+	BOOST_CHECK((*it).first.second == DOF::RZ);
+	BOOST_CHECK(is_equal((*it).second, 2.0));
+	++it;
+	BOOST_CHECK(it == matrix.end());
+
+	DOFMatrix rotations;
+	rotations.setComponent(DOF::RX, DOF::RX, 3.0);
+	BOOST_CHECK(rotations.hasRotations());
+	BOOST_CHECK(!rotations.hasTranslations());
+	BOOST_CHECK(rotations.isDiagonal());
+}
@@ -5,6 +5,7 @@
 
 #define BOOST_TEST_MODULE mesh_test
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include "../../Abstract/MeshComponents.h"
 #include "../../Abstract/Mesh.h"
 
@@ -36,6 +37,30 @@ BOOST_AUTO_TEST_CASE( test_NodeGroup2Families ) {
 	BOOST_CHECK(famGN1_GN2_found);
 }
 
+BOOST_AUTO_TEST_CASE( test_NodeGroup2Families_long_names ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	vector<NodeGroup *> nodeGroups;
+	const string longName(MED_LNAME_SIZE / 2, 'G');
+	for (int i = 0; i < 3; i++) {
+		NodeGroup* group = mesh.findOrCreateNodeGroup(longName + to_string(i));
+		group->addNodeByPosition(0);
+		group->addNodeByPosition(i + 1);
+		nodeGroups.push_back(group);
+	}
+	NodeGroup2Families ng(4, nodeGroups);
+	// the family of groups 0 and 1 has a too long name, its child builds on the short one
+	const int expected[] = { 4, 1, 3, 5 };
+	const vector<int>& result = ng.getFamilyOnNodes();
+	BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), expected, expected + 4);
+	const vector<Family>& families = ng.getFamilies();
+	BOOST_REQUIRE_EQUAL((size_t )4, families.size());
+	BOOST_CHECK_EQUAL(families[0].name, longName + "0");
+	BOOST_CHECK_EQUAL(families[2].num, 4);
+	BOOST_CHECK_EQUAL(families[2].name, "Family2_" + longName + "2");
+	BOOST_CHECK_EQUAL(families[2].groups.size(), (size_t ) 3);
+	BOOST_CHECK_EQUAL(families[2].groups[0], nodeGroups[0]);
+}
+
 BOOST_AUTO_TEST_CASE( test_faceIds ) {
 	vector<int> nodeIds = { 101, 102, 103, 104, 105, 106, 107, 108 };
 	Mesh mesh(LogLevel::INFO, "test");
@@ -75,6 +100,56 @@ BOOST_AUTO_TEST_CASE( test_NodeGroup ) {
 	BOOST_ASSERT_MSG(groupById != nullptr, "Group found by id");
 }
 
+BOOST_AUTO_TEST_CASE( test_NodeGroup_positions ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	for (int i = 0; i < 10; i++) {
+		mesh.addNode(i + 1, i, 0., 0.);
+	}
+	NodeGroup* group = mesh.findOrCreateNodeGroup("positions");
+	group->addNodeByPosition(2);
+	group->addNodeByPosition(5);
+	group->addNodesByPosition({ 7, 1, 5, 9, 2 });
+	group->addNodeByPosition(0);
+	group->addNodeByPosition(5);
+	// Out of order positions are only appended, but reading the group sees them
+	BOOST_CHECK_EQUAL(group->size(), (size_t ) 6);
+	BOOST_CHECK(group->containsNodePosition(0));
+	BOOST_CHECK_THROW(group->getNodePositions(), logic_error);
+	mesh.sortNodeGroups();
+	BOOST_CHECK_EQUAL(group->size(), (size_t ) 6);
+	const vector<int> expected = { 0, 1, 2, 5, 7, 9 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(group->getNodePositions().begin(), group->getNodePositions().end(),
+			expected.begin(), expected.end());
+	BOOST_CHECK(group->containsNodePosition(7));
+	BOOST_CHECK(!group->containsNodePosition(8));
+	group->removeNodeByPosition(7);
+	BOOST_CHECK(!group->containsNodePosition(7));
+	BOOST_CHECK_THROW(group->removeNodeByPosition(7), logic_error);
+	BOOST_CHECK_EQUAL(group->nodePositions().size(), (size_t ) 5);
+}
+
+BOOST_AUTO_TEST_CASE( test_NodeGroup_reverse_order ) {
+	// As an SPC1 THRU on nodes declared in decreasing id order
+	const int nodeCount = 200000;
+	Mesh mesh(LogLevel::INFO, "test");
+	for (int id = nodeCount; id >= 1; id--) {
+		mesh.addNode(id, id, 0., 0.);
+	}
+	NodeGroup* group = mesh.findOrCreateNodeGroup("reverse");
+	for (int id = 1; id <= nodeCount; id++) {
+		group->addNode(id);
+	}
+	group->addNode(nodeCount);
+	BOOST_CHECK_EQUAL(group->size(), static_cast<size_t>(nodeCount));
+	mesh.finish();
+	const vector<int>& positions = group->getNodePositions();
+	BOOST_REQUIRE_EQUAL(positions.size(), static_cast<size_t>(nodeCount));
+	BOOST_CHECK_EQUAL(positions.front(), 0);
+	BOOST_CHECK_EQUAL(positions.back(), nodeCount - 1);
+	BOOST_CHECK(is_sorted(positions.begin(), positions.end()));
+	BOOST_CHECK_EQUAL(group->getNodeIds().size(), static_cast<size_t>(nodeCount));
+}
+
 BOOST_AUTO_TEST_CASE( test_node_iterator ) {
 	Mesh mesh(LogLevel::INFO, "test");
 	double coords[12] = { 1.0, 250., 0., 433., 250., 0., 0., -500., 0., 0., 0., 1000. };
@@ -123,6 +198,114 @@ BOOST_AUTO_TEST_CASE( test_node_iterator ) {
 	}
 	BOOST_CHECK_EQUAL(mesh.countNodes(), i);
 }
+BOOST_AUTO_TEST_CASE( test_position_index ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	// compact numbering, then ids far away from it, then ids filling the gap
+	vector<int> nodeIds;
+	for (int id = 1000; id < 1100; id++) {
+		nodeIds.push_back(id);
+	}
+	nodeIds.push_back(50000000);
+	nodeIds.push_back(-7);
+	nodeIds.push_back(INT_MAX - 1);
+	for (int id = 999; id > 900; id--) {
+		nodeIds.push_back(id);
+	}
+	for (int id = 1100; id < 10000; id++) {
+		nodeIds.push_back(id);
+	}
+	for (int nodeId : nodeIds) {
+		mesh.addNode(nodeId, nodeId, 0., 0.);
+	}
+	BOOST_CHECK_EQUAL(mesh.countNodes(), static_cast<int>(nodeIds.size()));
+	for (size_t i = 0; i < nodeIds.size(); i++) {
+		BOOST_CHECK_EQUAL(mesh.findNodePosition(nodeIds[i]), static_cast<int>(i));
+	}
+	BOOST_CHECK(mesh.findNodePosition(900) == Node::UNAVAILABLE_NODE);
+	BOOST_CHECK(mesh.findNodePosition(50000001) == Node::UNAVAILABLE_NODE);
+	BOOST_CHECK(mesh.findNodePosition(INT_MIN + 1) == Node::UNAVAILABLE_NODE);
+	// adding an existing node keeps its position
+	BOOST_CHECK_EQUAL(mesh.addNode(50000000, 1., 2., 3.), 100);
+
+	BOOST_CHECK_EQUAL(mesh.addCell(5, CellType::SEG2, {1000, 1001}), 0);
+	BOOST_CHECK_EQUAL(mesh.addCell(3000000, CellType::SEG2, {1001, 1002}), 1);
+	BOOST_CHECK_EQUAL(mesh.addCell(6, CellType::SEG2, {1002, 1003}), 2);
+	BOOST_CHECK_EQUAL(mesh.countCells(), 3);
+	BOOST_CHECK(mesh.hasCell(3000000));
+	BOOST_CHECK(!mesh.hasCell(4));
+	int updatedPosition = mesh.updateCell(3000000, CellType::SEG2, {1003, 1004});
+	BOOST_CHECK_EQUAL(mesh.findCellPosition(3000000), updatedPosition);
+	BOOST_CHECK_EQUAL(mesh.countCells(), 3);
+}
+
+BOOST_AUTO_TEST_CASE( test_cell_connectivity ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	mesh.addCell(1, CellType::TRI3, {1, 2, 3});
+	mesh.addCell(2, CellType::SEG2, {3, 4});
+	mesh.addCell(3, CellType::TRI3, {4, 2, 1});
+	BOOST_CHECK(mesh.cells.connectivity(CellType::QUAD4) == nullptr);
+	const CellConnectivity* tri3 = mesh.cells.connectivity(CellType::TRI3);
+	BOOST_ASSERT(tri3 != nullptr);
+	// nodes are reserved in order of appearance
+	vector<int> expected = { 0, 1, 2, 3, 1, 0 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(tri3->allNodePositions().begin(), tri3->allNodePositions().end(),
+			expected.begin(), expected.end());
+	BOOST_CHECK(tri3->cellOffsets().empty());
+	BOOST_CHECK_EQUAL(tri3->size(1), 3u);
+	BOOST_CHECK_EQUAL(tri3->cellNodePositions(1)[0], 3);
+
+	const Cell cell = mesh.findCell(mesh.findCellPosition(3));
+	vector<int> expectedIds = { 4, 2, 1 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(cell.nodeIds.begin(), cell.nodeIds.end(),
+			expectedIds.begin(), expectedIds.end());
+	const Cell seg = mesh.findCell(mesh.findCellPosition(2));
+	BOOST_CHECK_EQUAL(seg.nodePositions[1], 3);
+}
+
+BOOST_AUTO_TEST_CASE( test_cell_view ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	mesh.addCell(7, CellType::QUAD4, {11, 12, 13, 14}, true, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, 3);
+	const int cellPosition = mesh.findCellPosition(7);
+	const Cell cell = mesh.findCell(cellPosition);
+	const CellView view = mesh.findCellView(cellPosition);
+	BOOST_CHECK_EQUAL(view.id(), cell.id);
+	BOOST_CHECK_EQUAL(view.type().code, cell.type.code);
+	BOOST_CHECK_EQUAL(view.elementId(), 3);
+	BOOST_CHECK(view.isvirtual());
+	BOOST_CHECK(!view.hasOrientation());
+	BOOST_CHECK_EQUAL(view.numNodes(), cell.nodeIds.size());
+	BOOST_CHECK_EQUAL_COLLECTIONS(view.nodePositions().begin(), view.nodePositions().end(),
+			cell.nodePositions.begin(), cell.nodePositions.end());
+	for (size_t i = 0; i < view.numNodes(); i++) {
+		BOOST_CHECK_EQUAL(view.nodeId(i), cell.nodeIds[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_cells_of_node ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	// enough cells to build the index, then a few more which are scanned
+	for (int id = 1; id <= 2000; id++) {
+		mesh.addCell(id, CellType::SEG2, {id, id + 1});
+	}
+	const int nodePosition = mesh.findNodePosition(11);
+	vector<int> expected = { mesh.findCellPosition(10), mesh.findCellPosition(11) };
+	vector<int> cellPositions = mesh.findCellPositionsOfNode(nodePosition);
+	BOOST_CHECK_EQUAL_COLLECTIONS(cellPositions.begin(), cellPositions.end(),
+			expected.begin(), expected.end());
+	const int triPosition = mesh.addCell(3000, CellType::TRI3, {11, 500, 501});
+	// the updated cell no longer uses node 11
+	const int updatedPosition = mesh.updateCell(10, CellType::SEG2, {9, 12});
+	expected = { mesh.findCellPosition(11), triPosition };
+	cellPositions = mesh.findCellPositionsOfNode(nodePosition);
+	BOOST_CHECK_EQUAL_COLLECTIONS(cellPositions.begin(), cellPositions.end(),
+			expected.begin(), expected.end());
+	cellPositions = mesh.findCellPositionsOfNode(mesh.findNodePosition(12));
+	expected = { mesh.findCellPosition(11), mesh.findCellPosition(12), updatedPosition };
+	BOOST_CHECK_EQUAL_COLLECTIONS(cellPositions.begin(), cellPositions.end(),
+			expected.begin(), expected.end());
+	BOOST_CHECK(mesh.findCellPositionsOfNode(mesh.addNode(5000, 0., 0., 0.)).empty());
+}
+
 /* API change, review the test
  BOOST_AUTO_TEST_CASE( test_CellGroup2Families ) {
  vector<CellGroup *> cellGroups;
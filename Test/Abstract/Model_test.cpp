@@ -13,6 +13,7 @@
 #include "../../Abstract/Model.h"
 #include <cstddef>
 #include <new>
+#include <sstream>
 #include <string>
 #include <vector>
 #if defined VDEBUG && defined __GNUC__
@@ -243,6 +244,22 @@ BOOST_AUTO_TEST_CASE( test_create_skin2d ) {
 			expectedFace1NodeIds.begin(), expectedFace1NodeIds.end());
 }
 
+BOOST_AUTO_TEST_CASE( test_finish_report ) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	BOOST_CHECK(model->finishPassReports.empty());
+	model->finish();
+	BOOST_REQUIRE(!model->finishPassReports.empty());
+	BOOST_CHECK_EQUAL(model->finishPassReports.front().name, "buildCoordinateSystems");
+	BOOST_CHECK_EQUAL(model->finishPassReports.back().name, "addDefaultAnalysis");
+	BOOST_CHECK_EQUAL(model->finishPassReports.back().cellCount, model->mesh->countCells());
+	BOOST_CHECK_EQUAL(model->finishPassReports.back().nodeCount, model->mesh->countNodes());
+
+	ostringstream report;
+	model->writeFinishReport(report);
+	BOOST_CHECK_EQUAL(report.str().front(), '{');
+	BOOST_CHECK(report.str().find("{\"name\": \"addDefaultAnalysis\", \"seconds\": ") != string::npos);
+}
+
 BOOST_AUTO_TEST_CASE(test_Analysis) {
 	ModelConfiguration configuration(false, LogLevel::DEBUG, false, false, false, false, false);
 	Model model("inputfile", "10.3", SolverName::NASTRAN, configuration);
@@ -360,6 +377,45 @@ BOOST_AUTO_TEST_CASE( combined_loadset1 ) {
 	BOOST_CHECK_EQUAL(model.getLoadingsByLoadSet(combination).size(), (size_t ) 3);
 }
 
+BOOST_AUTO_TEST_CASE( remove_from_sets ) {
+	Model model("inputfile", "10.3", SolverName::NASTRAN);
+	model.mesh->addNode(1, 0.0, 0.0, 0.0);
+	LoadSet loadSet1(model, LoadSet::LOAD, 1);
+	LoadSet loadSet2(model, LoadSet::LOAD, 2);
+	NodalForce force1(model, 1, 1.0);
+	model.add(force1);
+	model.addLoadingIntoLoadSet(force1, loadSet1);
+	model.addLoadingIntoLoadSet(force1, loadSet2);
+	NodalForce force2(model, 1, 2.0);
+	model.add(force2);
+	model.addLoadingIntoLoadSet(force2, loadSet1);
+	model.remove(force1.getReference());
+	BOOST_CHECK(model.find(force1.getReference()) == nullptr);
+	BOOST_CHECK_EQUAL(model.getLoadingsByLoadSet(loadSet1).size(), (size_t ) 1);
+	BOOST_CHECK_EQUAL(model.getLoadingsByLoadSet(loadSet2).size(), (size_t ) 0);
+
+	ConstraintSet constraintSet(model, ConstraintSet::SPC, 3);
+	SinglePointConstraint spc1(model, DOFS::ALL_DOFS);
+	spc1.addNodeId(1);
+	model.add(spc1);
+	model.addConstraintIntoConstraintSet(spc1, constraintSet);
+	model.addConstraintIntoConstraintSet(spc1, model.commonConstraintSet);
+	SinglePointConstraint spc2(model, DOFS::ALL_DOFS);
+	spc2.addNodeId(1);
+	model.add(spc2);
+	model.addConstraintIntoConstraintSet(spc2, constraintSet);
+	// Only removed from the given set
+	model.remove(spc1.getReference(), model.commonConstraintSet.getId(),
+			model.commonConstraintSet.getOriginalId(), model.commonConstraintSet.type);
+	BOOST_CHECK_EQUAL(model.getConstraintsByConstraintSet(model.commonConstraintSet).size(), (size_t ) 0);
+	BOOST_CHECK_EQUAL(model.getConstraintsByConstraintSet(constraintSet).size(), (size_t ) 2);
+	model.add(spc1);
+	model.remove(spc1.getReference());
+	BOOST_CHECK_EQUAL(model.getConstraintsByConstraintSet(constraintSet).size(), (size_t ) 1);
+	model.remove(spc2.getReference());
+	BOOST_CHECK_EQUAL(model.getConstraintsByConstraintSet(constraintSet).size(), (size_t ) 0);
+}
+
 BOOST_AUTO_TEST_CASE( reference_compare ) {
 	Reference<LoadSet> rauto1(LoadSet::LOAD, Reference<LoadSet>::NO_ID, 1);
 	BOOST_CHECK(rauto1 == rauto1);
@@ -7,6 +7,7 @@
 #include "build_properties.h"
 #include "../../Abstract/Utility.h"
 #include <boost/test/unit_test.hpp>
+#include <sstream>
 
 using namespace std;
 using namespace vega;
@@ -56,3 +57,26 @@ BOOST_AUTO_TEST_CASE( valueOrReference_ref ) {
 	ValueOrReference ref2a = ref2;
 	BOOST_CHECK_EQUAL(ref2a, ref2);
 }
+
+BOOST_AUTO_TEST_CASE( test_format_integer ) {
+	char digits[INTEGER_TEXT_SIZE];
+	char* end = digits + sizeof(digits);
+	for (long long value : { 0ll, 7ll, -42ll, 1234567890ll, LLONG_MAX, LLONG_MIN }) {
+		BOOST_CHECK_EQUAL(string(formatInteger(value, end), end), to_string(value));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_text_buffer ) {
+	ostringstream out;
+	out.precision(6);
+	{
+		TextBuffer buffer(out, 8);
+		buffer.append(-12).append(' ').append(3.25).append(' ').append(1.0 / 3.0);
+		// Only endLine() and flushIfFull() hand a full buffer to the stream
+		BOOST_CHECK(out.str().empty());
+		buffer.endLine();
+		BOOST_CHECK_EQUAL(out.str(), "-12 3.25 0.333333\n");
+		buffer.append("N").append(123456789012ll);
+	}
+	BOOST_CHECK_EQUAL(out.str(), "-12 3.25 0.333333\nN123456789012");
+}
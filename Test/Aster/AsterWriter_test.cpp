@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ */
+
+#define BOOST_TEST_MODULE aster_writer_test
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include "../../Aster/AsterFacade.h"
+#include "../../Nastran/NastranFacade.h"
+
+using namespace std;
+using namespace vega;
+namespace fs = boost::filesystem;
+
+namespace {
+
+string readFile(const fs::path& path) {
+	ifstream in(path.string());
+	ostringstream content;
+	content << in.rdbuf();
+	return content.str();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_constraint_node_groups ) {
+	const fs::path directory = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%");
+	fs::create_directories(directory);
+	const fs::path deckPath = directory / "cube.dat";
+	{
+		// A cube clamped on its 4 bottom nodes, with an RBE3 on its 4 top nodes
+		ofstream deck(deckPath.string());
+		deck << "SOL 101\nCEND\nDISPLACEMENT=ALL\nLOAD=1\nSPC=1\nBEGIN BULK\n"
+				"GRID,1,,0.,0.,0.\nGRID,2,,1.,0.,0.\nGRID,3,,1.,1.,0.\nGRID,4,,0.,1.,0.\n"
+				"GRID,5,,0.,0.,1.\nGRID,6,,1.,0.,1.\nGRID,7,,1.,1.,1.\nGRID,8,,0.,1.,1.\n"
+				"GRID,9,,0.5,0.5,2.\n"
+				"CHEXA,1,34,1,2,3,4,5,6,+\n+,7,8\n"
+				"SPC1,1,123,1,THRU,4\n"
+				"RBE3,10,,9,123456,1.,123,5,6,+\n+,7,8\n"
+				"FORCE,1,9,,1.,0.,0.,-1.\n"
+				"MAT1,1,210000.,,0.3,7.85-9\n"
+				"PSOLID,34,1\n"
+				"ENDDATA\n";
+	}
+	ConfigurationParameters configuration(deckPath.string(), CODE_ASTER, "", "cube",
+			directory.string(), LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02,
+			false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", { }, "table", 9, "direct",
+			false, 4);
+	nastran::NastranParser parser;
+	shared_ptr<Model> model = parser.parse(configuration);
+	model->finish();
+
+	aster::AsterWriter writer;
+	const fs::path commPath = fs::path(writer.writeModel(model, configuration)).replace_extension(
+			".comm");
+	const string comm = readFile(commPath);
+	BOOST_CHECK_NE(comm.find("GROUP_NO='CSPC"), string::npos);
+	BOOST_CHECK_NE(comm.find("GROUP_NO_ESCL='CRBE"), string::npos);
+
+	// The groups are in the mesh written to the MED file
+	size_t groupCount = 0;
+	for (NodeGroup* nodeGroup : model->mesh->getNodeGroups()) {
+		const string name = nodeGroup->getName();
+		if (name.compare(0, 4, "CSPC") == 0 || name.compare(0, 4, "CRBE") == 0) {
+			BOOST_CHECK_EQUAL(nodeGroup->nodePositions().size(), 4u);
+			groupCount++;
+		}
+	}
+	BOOST_CHECK_EQUAL(groupCount, 2u);
+
+	// Writing the same model again gives the same .comm and the same groups
+	const size_t nodeGroupCount = model->mesh->getNodeGroups().size();
+	aster::AsterWriter otherWriter;
+	otherWriter.writeModel(model, configuration);
+	BOOST_CHECK_EQUAL(readFile(commPath), comm);
+	BOOST_CHECK_EQUAL(model->mesh->getNodeGroups().size(), nodeGroupCount);
+	fs::remove_all(directory);
+}
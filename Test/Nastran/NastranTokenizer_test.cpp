@@ -33,6 +33,7 @@ using namespace std;
 
 #include "build_properties.h"
 #include "../../Nastran/NastranTokenizer.h"
+#include "../../Nastran/NastranWriter.h"
 
 BOOST_AUTO_TEST_CASE(nastran_short_with_comments) {
     string nastranLine = "$comment comment \nKEYWORD 12345\n2NDLINE 1234567 1234567 ";
@@ -310,3 +311,102 @@ void countGridElems(NastranTokenizer& tok) {
     BOOST_CHECK_EQUAL(4, symcount);
 }
 
+
+BOOST_AUTO_TEST_CASE(nastran_mapped_file) {
+    string testLocation = fs::path(
+            PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/included.dat").make_preferred().string();
+    NastranTokenizer tok(testLocation);
+    tok.bulkSection();
+    tok.nextLine();
+    BOOST_CHECK_EQUAL(tok.nextSymbolType, NastranTokenizer::SYMBOL_KEYWORD);
+    BOOST_CHECK_EQUAL("MAT1", tok.nextString());
+    BOOST_CHECK_EQUAL(1, tok.nextInt());
+    BOOST_CHECK_CLOSE(19.9E4, tok.nextDouble(), 1e-12);
+    BOOST_CHECK(tok.isNextEmpty());
+    tok.skip(1);
+    BOOST_CHECK_CLOSE(.3, tok.nextDouble(), 1e-12);
+    tok.nextLine();
+    BOOST_CHECK_EQUAL(tok.nextSymbolType, NastranTokenizer::SYMBOL_EOF);
+}
+
+BOOST_AUTO_TEST_CASE(decode_numeric_fields) {
+    double d = 0;
+    BOOST_CHECK(NastranTokenizer::decodeDouble("1.5-3", d));
+    BOOST_CHECK_CLOSE(1.5E-3, d, 1e-12);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("-2.D+2", d));
+    BOOST_CHECK_CLOSE(-200., d, 1e-12);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("-.5e1", d));
+    BOOST_CHECK_CLOSE(-5., d, 1e-12);
+    BOOST_CHECK(NastranTokenizer::decodeDouble("12", d));
+    BOOST_CHECK_CLOSE(12., d, 1e-12);
+    BOOST_CHECK(!NastranTokenizer::decodeDouble("1.2.3", d));
+    BOOST_CHECK(!NastranTokenizer::decodeDouble("1.E", d));
+    BOOST_CHECK(!NastranTokenizer::decodeDouble("+", d));
+    BOOST_CHECK(!NastranTokenizer::decodeDouble("ABC", d));
+    int i = 0;
+    BOOST_CHECK(NastranTokenizer::decodeInt("-2147483648", i));
+    BOOST_CHECK_EQUAL(-2147483647 - 1, i);
+    BOOST_CHECK(NastranTokenizer::decodeInt("+42", i));
+    BOOST_CHECK_EQUAL(42, i);
+    BOOST_CHECK(!NastranTokenizer::decodeInt("2147483648", i));
+    BOOST_CHECK(!NastranTokenizer::decodeInt("1.", i));
+    BOOST_CHECK(!NastranTokenizer::decodeInt("-", i));
+}
+
+BOOST_AUTO_TEST_CASE(nastran_preloaded_bulk) {
+    string nastranLine = "$comment\nGRID,1,,0.,1.5-3,2.\nCQUAD4  1       2       1       2       3       4\n";
+    istringstream istr(nastranLine);
+    NastranTokenizer tok(istr);
+    tok.preloadBulkSection();
+    tok.bulkSection();
+    tok.nextLine();
+    BOOST_CHECK_EQUAL(tok.nextSymbolType, NastranTokenizer::SYMBOL_KEYWORD);
+    BOOST_CHECK_EQUAL("GRID", tok.nextString());
+    BOOST_CHECK_EQUAL(1, tok.nextInt());
+    BOOST_CHECK(tok.isNextEmpty());
+    tok.skip(2);
+    BOOST_CHECK_CLOSE(1.5E-3, tok.nextDouble(), 1e-12);
+    BOOST_CHECK_EQUAL(2, tok.getLineNumber());
+    tok.nextLine();
+    BOOST_CHECK_EQUAL("CQUAD4", tok.nextString());
+    BOOST_CHECK_EQUAL(3, tok.getLineNumber());
+    tok.nextLine();
+    BOOST_CHECK_EQUAL(tok.nextSymbolType, NastranTokenizer::SYMBOL_EOF);
+}
+
+BOOST_AUTO_TEST_CASE(nastran_writer_line) {
+    char text[32];
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(0.0, 8, text)), "0.");
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(3.0, 8, text)), "3.");
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(-0.5, 8, text)), "-.5");
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(7.85e-9, 8, text)), "7.85-9");
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(1.0 / 3.0, 8, text)), ".3333333");
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(-123456789.0, 8, text)), "-1.235+8");
+    BOOST_CHECK_EQUAL(string(text, vega::nastran::Line::formatReal(-123456789.0, 16, text)), "-123456789.");
+
+    // Fields 2 to 9 on the first line, then a continuation line
+    ostringstream out;
+    out << vega::nastran::Line("CHEXA").add(12).add(3).add(vector<int> { 1, 2, 3, 4, 5, 6, 7, 8 });
+    out << vega::nastran::Line("GRID").add(100000).add().add(1.0 / 3.0).add(-2.5e-12).add(1.0e7);
+    BOOST_CHECK_EQUAL(out.str(),
+            "CHEXA         12       3       1       2       3       4       5       6\n"
+            "               7       8\n"
+            "GRID      100000        .3333333 -2.5-12    1.+7\n");
+    BOOST_CHECK_THROW(vega::nastran::Line("GRID").add(123456789), invalid_argument);
+
+    istringstream istr(out.str());
+    NastranTokenizer tokenizer(istr);
+    tokenizer.bulkSection();
+    tokenizer.nextLine();
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "CHEXA");
+    for (int value : { 12, 3, 1, 2, 3, 4, 5, 6, 7, 8 }) {
+        BOOST_CHECK_EQUAL(tokenizer.nextInt(), value);
+    }
+    tokenizer.nextLine();
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "GRID");
+    BOOST_CHECK_EQUAL(tokenizer.nextInt(), 100000);
+    BOOST_CHECK_EQUAL(tokenizer.nextString(true, ""), "");
+    BOOST_CHECK_CLOSE(tokenizer.nextDouble(), 1.0 / 3.0, 1e-4);
+    BOOST_CHECK_CLOSE(tokenizer.nextDouble(), -2.5e-12, 1e-10);
+    BOOST_CHECK_CLOSE(tokenizer.nextDouble(), 1.0e7, 1e-10);
+}
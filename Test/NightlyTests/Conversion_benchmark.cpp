@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Conversion_benchmark.cpp
+ *
+ * Timings of each stage of the conversion pipeline (parse, finish, validate, write)
+ * on a synthetic Nastran deck, for the Aster, Systus and Nastran writers.
+ *
+ * The deck is a cube of N x N x N CHEXA with CQUAD4 on its top face, RBE2 linking
+ * extra nodes to some of the top quads, and a DMIG stiffness on these extra nodes.
+ * N defaults to 30 and can be given as the first argument after the Boost.Test ones:
+ *     Conversion_benchmark -- 60
+ *
+ * The Aster writer is also timed on a plate clamped by a single SPC1 on its 100k nodes,
+ * with the node list written inline and as a MED node group.
+ *
+ * The Systus writer is also timed on the cube with SYSTUS_SUBCASES static subcases,
+ * each written in its own ASC file.
+ */
+
+#define BOOST_TEST_MODULE conversion_benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "../../Abstract/Model.h"
+#include "../../Nastran/NastranFacade.h"
+#include "../../Aster/AsterFacade.h"
+#include "../../Systus/SystusWriter.h"
+
+using namespace std;
+using namespace vega;
+namespace fs = boost::filesystem;
+
+namespace {
+
+const int DEFAULT_SIZE = 30;
+/**
+ * One RBE2 every RBE2_STRIDE quads of the top face.
+ */
+const int RBE2_STRIDE = 4;
+/**
+ * Number of subcases of the cube for the Systus subcases benchmark.
+ */
+const int SYSTUS_SUBCASES = 40;
+
+double secondsSince(const chrono::steady_clock::time_point& start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int benchmarkSize() {
+	const auto& suite = boost::unit_test::framework::master_test_suite();
+	for (int i = 1; i < suite.argc; i++) {
+		const int size = atoi(suite.argv[i]);
+		if (size > 0) {
+			return size;
+		}
+	}
+	return DEFAULT_SIZE;
+}
+
+/**
+ * Writes a small field Nastran card, continuation lines included.
+ */
+class CardWriter final {
+	ofstream& out;
+	int fieldCount = 0;
+	int continuationCount = 0;
+public:
+	long cardCount = 0;
+
+	explicit CardWriter(ofstream& out) :
+			out(out) {
+	}
+	CardWriter& start(const char* keyword) {
+		if (fieldCount > 0) {
+			out << "\n";
+		}
+		char field[16];
+		snprintf(field, sizeof(field), "%-8.8s", keyword);
+		out << field;
+		fieldCount = 1;
+		cardCount++;
+		return *this;
+	}
+	CardWriter& field(const string& value) {
+		if (fieldCount == 9) {
+			char marker[16];
+			snprintf(marker, sizeof(marker), "+C%06d", ++continuationCount % 1000000);
+			out << marker << "\n" << marker;
+			fieldCount = 1;
+		}
+		char field[16];
+		snprintf(field, sizeof(field), "%8.8s", value.c_str());
+		out << field;
+		fieldCount++;
+		return *this;
+	}
+	CardWriter& field(int value) {
+		return field(to_string(value));
+	}
+	CardWriter& field(double value) {
+		char field[16];
+		snprintf(field, sizeof(field), "%8.3f", value);
+		return this->field(string(field));
+	}
+	void end() {
+		if (fieldCount > 0) {
+			out << "\n";
+		}
+		fieldCount = 0;
+	}
+};
+
+struct SyntheticDeck {
+	fs::path path;
+	long cardCount;
+};
+
+SyntheticDeck writeDeck(const fs::path& directory, int n, int subcaseCount = 0) {
+	SyntheticDeck deck;
+	deck.path = directory / "synthetic.dat";
+	ofstream out(deck.path.string());
+	out << "SOL 101\nCEND\n"
+			"DISPLACEMENT=ALL\n"
+			"SPC=1\n"
+			"LOAD=1\n"
+			"K2GG=KAAX\n";
+	for (int subcase = 1; subcase <= subcaseCount; subcase++) {
+		out << "SUBCASE " << subcase << "\n  LOAD=1\n";
+	}
+	out << "BEGIN BULK\n";
+	CardWriter card(out);
+	const int m = n + 1;
+	auto nodeId = [m](int i, int j, int k) {return 1 + i + m * (j + m * k);};
+	for (int k = 0; k < m; k++) {
+		for (int j = 0; j < m; j++) {
+			for (int i = 0; i < m; i++) {
+				card.start("GRID").field(nodeId(i, j, k)).field("").field(i * 1.).field(j * 1.).field(
+						k * 1.);
+			}
+		}
+	}
+	int cellId = 1;
+	for (int k = 0; k < n; k++) {
+		for (int j = 0; j < n; j++) {
+			for (int i = 0; i < n; i++) {
+				card.start("CHEXA").field(cellId++).field(1);
+				card.field(nodeId(i, j, k)).field(nodeId(i + 1, j, k)).field(nodeId(i + 1, j + 1, k)).field(
+						nodeId(i, j + 1, k));
+				card.field(nodeId(i, j, k + 1)).field(nodeId(i + 1, j, k + 1)).field(
+						nodeId(i + 1, j + 1, k + 1)).field(nodeId(i, j + 1, k + 1));
+			}
+		}
+	}
+	// Shells on the top face, and RBE2 from an extra node above some of them
+	int extraNodeId = m * m * m;
+	int quadCount = 0;
+	vector<int> extraNodes;
+	for (int j = 0; j < n; j++) {
+		for (int i = 0; i < n; i++) {
+			const int quadNodes[4] = { nodeId(i, j, n), nodeId(i + 1, j, n), nodeId(i + 1, j + 1, n),
+					nodeId(i, j + 1, n) };
+			card.start("CQUAD4").field(cellId++).field(2);
+			for (int quadNode : quadNodes) {
+				card.field(quadNode);
+			}
+			if (quadCount++ % RBE2_STRIDE == 0) {
+				extraNodes.push_back(++extraNodeId);
+				card.start("GRID").field(extraNodeId).field("").field(i + .5).field(j + .5).field(n + 1.);
+				card.start("RBE2").field(cellId++).field(extraNodeId).field(123456);
+				for (int quadNode : quadNodes) {
+					card.field(quadNode);
+				}
+			}
+		}
+	}
+	card.start("SPC1").field(1).field(123456).field(1).field("THRU").field(m * m);
+	card.start("MAT1").field(1).field("210000.").field("").field(0.3).field("7.85-9");
+	card.start("PSOLID").field(1).field(1);
+	card.start("PSHELL").field(2).field(1).field(0.1).field(1);
+	// Springs between pairs of extra nodes: a lone diagonal term is not supported by Model::finish
+	card.start("DMIG").field("KAAX").field(0).field(6).field(1);
+	for (size_t i = 0; i + 1 < extraNodes.size(); i += 2) {
+		const int node1 = extraNodes[i];
+		const int node2 = extraNodes[i + 1];
+		card.start("DMIG").field("KAAX").field(node1).field(3).field("").field(node1).field(3).field(
+				"1000.");
+		card.start("DMIG").field("KAAX").field(node2).field(3).field("").field(node1).field(3).field(
+				"-500.").field("").field(node2).field(3).field("1000.");
+	}
+	for (int extraNode : extraNodes) {
+		card.start("FORCE").field(1).field(extraNode).field("").field(1.).field(0.).field(0.).field(
+				-1.);
+	}
+	card.end();
+	out << "ENDDATA\n";
+	deck.cardCount = card.cardCount;
+	return deck;
+}
+
+/**
+ * Plate of n x n CQUAD4 clamped on all its nodes by a single SPC1.
+ */
+SyntheticDeck writeClampedPlate(const fs::path& directory, int n) {
+	SyntheticDeck deck;
+	deck.path = directory / "plate.dat";
+	ofstream out(deck.path.string());
+	out << "SOL 101\nCEND\n"
+			"DISPLACEMENT=ALL\n"
+			"SPC=1\n"
+			"BEGIN BULK\n";
+	CardWriter card(out);
+	const int m = n + 1;
+	auto nodeId = [m](int i, int j) {return 1 + i + m * j;};
+	for (int j = 0; j < m; j++) {
+		for (int i = 0; i < m; i++) {
+			card.start("GRID").field(nodeId(i, j)).field("").field(i * 1.).field(j * 1.).field(0.);
+		}
+	}
+	int cellId = 1;
+	for (int j = 0; j < n; j++) {
+		for (int i = 0; i < n; i++) {
+			card.start("CQUAD4").field(cellId++).field(1).field(nodeId(i, j)).field(nodeId(i + 1, j)).field(
+					nodeId(i + 1, j + 1)).field(nodeId(i, j + 1));
+		}
+	}
+	card.start("SPC1").field(1).field(123456).field(1).field("THRU").field(m * m);
+	card.start("MAT1").field(1).field("210000.").field("").field(0.3).field("7.85-9");
+	card.start("PSHELL").field(1).field(1).field(0.1).field(1);
+	card.end();
+	out << "ENDDATA\n";
+	deck.cardCount = card.cardCount;
+	return deck;
+}
+
+void reportStage(const string& stage, double seconds, long count, const string& unit) {
+	const long throughput = static_cast<long>(static_cast<double>(count) / seconds);
+	cout << "  " << stage << ": " << seconds << " s, " << throughput << " " << unit << "/s" << endl;
+}
+
+/**
+ * Runs the whole pipeline of vegapp on a synthetic deck, timing each stage.
+ */
+void benchmarkConversion(Writer& writer, SolverName outputSolver, const string& name) {
+	const int n = benchmarkSize();
+	const fs::path directory = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%");
+	fs::create_directories(directory);
+	const SyntheticDeck deck = writeDeck(directory, n);
+	ConfigurationParameters configuration(deck.path.string(), outputSolver, "", "synthetic",
+			directory.string(), LogLevel::INFO, ConfigurationParameters::BEST_EFFORT);
+	cout << name << " on a " << n << "^3 cube, " << deck.cardCount << " cards" << endl;
+
+	nastran::NastranParser parser;
+	auto start = chrono::steady_clock::now();
+	shared_ptr<Model> model = parser.parse(configuration);
+	reportStage("parse", secondsSince(start), deck.cardCount, "cards");
+	const long cellCount = model->mesh->countCells();
+
+	start = chrono::steady_clock::now();
+	model->finish();
+	reportStage("finish", secondsSince(start), cellCount, "cells");
+
+	start = chrono::steady_clock::now();
+	const bool valid = model->validate();
+	reportStage("validate", secondsSince(start), cellCount, "cells");
+	BOOST_CHECK(valid);
+
+	start = chrono::steady_clock::now();
+	const string modelFile = writer.writeModel(model, configuration);
+	reportStage("write", secondsSince(start), cellCount, "cells");
+	BOOST_CHECK(fs::exists(modelFile));
+
+	fs::remove_all(directory);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_nastran2aster ) {
+	aster::AsterWriter writer;
+	benchmarkConversion(writer, CODE_ASTER, "Nastran to Aster");
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_nastran2systus ) {
+	SystusWriter writer;
+	benchmarkConversion(writer, SYSTUS, "Nastran to Systus");
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_nastran2nastran ) {
+	nastran::NastranWriter writer;
+	benchmarkConversion(writer, NASTRAN, "Nastran to Nastran");
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_aster_spc_node_groups ) {
+	// 317 x 317 nodes
+	const int n = 316;
+	const fs::path directory = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%");
+	fs::create_directories(directory);
+	const SyntheticDeck deck = writeClampedPlate(directory, n);
+	cout << "Aster SPC on " << (n + 1) * (n + 1) << " nodes" << endl;
+	for (int nodeGroupSize : { 0, 1000 }) {
+		ConfigurationParameters configuration(deck.path.string(), CODE_ASTER, "", "plate",
+				directory.string(), LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02,
+				false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", { }, "table", 9, "direct",
+				false, nodeGroupSize);
+		nastran::NastranParser parser;
+		shared_ptr<Model> model = parser.parse(configuration);
+		model->finish();
+		aster::AsterWriter writer;
+		const auto start = chrono::steady_clock::now();
+		const string modelFile = writer.writeModel(model, configuration);
+		const double seconds = secondsSince(start);
+		const fs::path commFile = fs::path(modelFile).replace_extension(".comm");
+		BOOST_CHECK(fs::exists(commFile));
+		cout << "  " << (nodeGroupSize == 0 ? "node list" : "node group") << ": write " << seconds
+				<< " s, .comm " << fs::file_size(commFile) << " bytes" << endl;
+	}
+	fs::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_systus_subcases ) {
+	const int n = benchmarkSize();
+	const fs::path directory = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%");
+	fs::create_directories(directory);
+	const SyntheticDeck deck = writeDeck(directory, n, SYSTUS_SUBCASES);
+	// Each analysis in its own subcase
+	ConfigurationParameters configuration(deck.path.string(), SYSTUS, "", "subcases",
+			directory.string(), LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02,
+			false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", { { -1 } });
+	cout << "Systus " << SYSTUS_SUBCASES << " subcases on a " << n << "^3 cube" << endl;
+	nastran::NastranParser parser;
+	shared_ptr<Model> model = parser.parse(configuration);
+	model->finish();
+	SystusWriter writer;
+	const auto start = chrono::steady_clock::now();
+	writer.writeModel(model, configuration);
+	const double seconds = secondsSince(start);
+	int ascCount = 0;
+	for (const auto& entry : fs::directory_iterator(directory)) {
+		if (entry.path().extension() == ".ASC") {
+			ascCount++;
+		}
+	}
+	BOOST_CHECK_EQUAL(ascCount, SYSTUS_SUBCASES);
+	cout << "  write " << seconds << " s" << endl;
+	fs::remove_all(directory);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * F06Parser_benchmark.cpp
+ *
+ * Timings of the reading of a large F06 displacement table, compared to a
+ * plain line by line read of the same file.
+ */
+
+#define BOOST_TEST_MODULE f06parser_benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include "../../Abstract/Model.h"
+#include "../../ResultReaders/F06Parser.h"
+
+using namespace std;
+using namespace vega;
+namespace fs = boost::filesystem;
+
+namespace {
+
+const int NODE_COUNT = 200000;
+const int SUBCASE_COUNT = 3;
+
+double secondsSince(const chrono::steady_clock::time_point& start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void writeF06(const fs::path& path) {
+	ofstream out(path.string());
+	char line[160];
+	for (int subcase = 1; subcase <= SUBCASE_COUNT; subcase++) {
+		out << "0                                                                                                            SUBCASE "
+				<< subcase << "\n \n";
+		out << "                                             D I S P L A C E M E N T   V E C T O R\n \n";
+		out << "      POINT ID.   TYPE          T1             T2             T3             R1             R2             R3\n";
+		for (int id = 1; id <= NODE_COUNT; id++) {
+			const double d = id * 1e-6;
+			snprintf(line, sizeof(line),
+					"%14d      G     %13.6E  %13.6E  %13.6E  %13.6E  %13.6E  %13.6E\n", id, d,
+					-d, 0.5 * d, 0., 2 * d, -3 * d);
+			out << line;
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_displacement_table ) {
+	const fs::path f06Path = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%.f06");
+	writeF06(f06Path);
+
+	auto start = chrono::steady_clock::now();
+	ifstream in(f06Path.string());
+	string line;
+	size_t lineCount = 0;
+	while (getline(in, line)) {
+		lineCount++;
+	}
+	in.close();
+	cout << "Reading " << lineCount << " lines: " << secondsSince(start) << " s" << endl;
+
+	shared_ptr<Model> model = make_shared<Model>("benchmark", "unknown", NASTRAN);
+	for (int id = 1; id <= NODE_COUNT; id++) {
+		model->mesh->addNode(id, id, 0., 0.);
+	}
+	for (int subcase = 1; subcase <= SUBCASE_COUNT; subcase++) {
+		model->add(LinearMecaStat(*model, "", subcase));
+	}
+	ConfigurationParameters configuration("benchmark", CODE_ASTER, "..", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, f06Path, 0.0003);
+
+	start = chrono::steady_clock::now();
+	result::F06Parser f06Parser;
+	f06Parser.add_assertions(configuration, model);
+	cout << "Parsing " << SUBCASE_COUNT << " displacement tables of " << NODE_COUNT << " nodes: "
+			<< secondsSince(start) << " s" << endl;
+	fs::remove(f06Path);
+
+	for (int subcase = 1; subcase <= SUBCASE_COUNT; subcase++) {
+		shared_ptr<Analysis> analysis = model->analyses.find(subcase);
+		BOOST_REQUIRE(analysis != nullptr);
+		BOOST_CHECK_EQUAL(analysis->getAssertions().size(), static_cast<size_t>(6 * NODE_COUNT));
+	}
+}
+
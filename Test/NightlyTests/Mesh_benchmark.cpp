@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Mesh_benchmark.cpp
+ *
+ * Timings of the node and cell id to position lookups on a large mesh.
+ */
+
+#define BOOST_TEST_MODULE mesh_benchmark
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "../../Abstract/Model.h"
+
+using namespace std;
+using namespace vega;
+
+namespace {
+
+const int NODE_COUNT = 5000000;
+const int CELL_COUNT = 10000000;
+
+atomic<long long> allocationCount(0);
+
+double secondsSince(const chrono::steady_clock::time_point& start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+}
+
+// Count the heap allocations made by this executable
+void* operator new(size_t size) {
+	allocationCount++;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) {
+		throw bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void* memory) noexcept {
+	free(memory);
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_node_lookup ) {
+	Mesh mesh(LogLevel::INFO, "benchmark");
+	auto start = chrono::steady_clock::now();
+	for (int id = 1; id <= NODE_COUNT; id++) {
+		mesh.addNode(id, id, 0., 0.);
+	}
+	cout << "Adding " << NODE_COUNT << " nodes: " << secondsSince(start) << " s" << endl;
+
+	start = chrono::steady_clock::now();
+	long long checksum = 0;
+	for (int pass = 0; pass < 4; pass++) {
+		// a stride which visits the ids in a cache unfriendly order
+		for (long long i = 0; i < NODE_COUNT; i++) {
+			const int id = static_cast<int>((i * 7919) % NODE_COUNT) + 1;
+			checksum += mesh.findNodePosition(id);
+		}
+	}
+	cout << "Looking up " << 4 * NODE_COUNT << " node ids: " << secondsSince(start) << " s" << endl;
+	BOOST_CHECK_EQUAL(checksum, 4 * (static_cast<long long>(NODE_COUNT) - 1) * NODE_COUNT / 2);
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_cell_creation ) {
+	Mesh mesh(LogLevel::INFO, "benchmark");
+	for (int id = 1; id <= NODE_COUNT; id++) {
+		mesh.addNode(id, id, 0., 0.);
+	}
+	// each cell looks up its nodes through findOrReserveNode
+	auto start = chrono::steady_clock::now();
+	for (int id = 1; id < NODE_COUNT; id++) {
+		mesh.addCell(id, CellType::SEG2, {id, id + 1});
+	}
+	cout << "Adding " << NODE_COUNT - 1 << " cells: " << secondsSince(start) << " s" << endl;
+	BOOST_CHECK_EQUAL(mesh.countCells(), NODE_COUNT - 1);
+	BOOST_CHECK_EQUAL(mesh.countNodes(), NODE_COUNT);
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_cell_view ) {
+	Mesh mesh(LogLevel::INFO, "benchmark");
+	for (int id = 1; id <= NODE_COUNT; id++) {
+		mesh.addNode(id, id, 0., 0.);
+	}
+	for (int id = 1; id <= CELL_COUNT; id++) {
+		mesh.addCell(id, CellType::SEG2, {id % NODE_COUNT + 1, (id + 1) % NODE_COUNT + 1});
+	}
+	const long long allocationsBefore = allocationCount;
+	auto start = chrono::steady_clock::now();
+	long long checksum = 0;
+	for (int cellPosition = 0; cellPosition < CELL_COUNT; cellPosition++) {
+		const CellView cell = mesh.findCellView(cellPosition);
+		checksum += cell.id();
+		for (int nodePosition : cell.nodePositions()) {
+			checksum += nodePosition;
+		}
+	}
+	cout << "Viewing " << CELL_COUNT << " cells: " << secondsSince(start) << " s" << endl;
+	BOOST_CHECK_EQUAL(allocationCount - allocationsBefore, 0);
+	BOOST_CHECK(checksum > 0);
+
+	start = chrono::steady_clock::now();
+	for (int cellPosition = 0; cellPosition < CELL_COUNT; cellPosition++) {
+		checksum += mesh.findCell(cellPosition).id;
+	}
+	cout << "Copying " << CELL_COUNT << " cells: " << secondsSince(start) << " s" << endl;
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_group_families ) {
+	const int cellCount = 1000000;
+	const int groupCount = 500;
+	Mesh mesh(LogLevel::INFO, "benchmark");
+	for (int id = 1; id <= cellCount + 1; id++) {
+		mesh.addNode(id, id, 0., 0.);
+	}
+	for (int id = 1; id <= cellCount; id++) {
+		mesh.addCell(id, CellType::SEG2, {id, id + 1});
+	}
+	// overlapping groups: group g holds one cell (and node) out of g + 2
+	vector<CellGroup*> cellGroups;
+	vector<NodeGroup*> nodeGroups;
+	for (int g = 0; g < groupCount; g++) {
+		CellGroup* cellGroup = mesh.createCellGroup("GC" + to_string(g));
+		NodeGroup* nodeGroup = mesh.findOrCreateNodeGroup("GN" + to_string(g));
+		for (int id = g + 2; id <= cellCount; id += g + 2) {
+			cellGroup->addCell(id);
+			nodeGroup->addNodeByPosition(id - 1);
+		}
+		cellGroups.push_back(cellGroup);
+		nodeGroups.push_back(nodeGroup);
+	}
+
+	auto start = chrono::steady_clock::now();
+	NodeGroup2Families nodeFamilies(mesh.countNodes(), nodeGroups);
+	cout << "Node families of " << groupCount << " groups: " << secondsSince(start) << " s, "
+			<< nodeFamilies.getFamilies().size() << " families" << endl;
+
+	unordered_map<CellType::Code, int, hash<int>> cellCountByType;
+	cellCountByType[CellType::SEG2_CODE] = cellCount;
+	start = chrono::steady_clock::now();
+	CellGroup2Families cellFamilies(&mesh, cellCountByType, cellGroups);
+	cout << "Cell families of " << groupCount << " groups: " << secondsSince(start) << " s, "
+			<< cellFamilies.getFamilies().size() << " families" << endl;
+	BOOST_CHECK_EQUAL(nodeFamilies.getFamilies().size(), cellFamilies.getFamilies().size());
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_global_coordinates ) {
+	Model model("benchmark");
+	model.add(CartesianCoordinateSystem(model, VectorialValue(1., 2., 3.), VectorialValue::Y,
+			VectorialValue::Z, 1));
+	model.add(CylindricalCoordinateSystem(model, VectorialValue(0., 0., 1.), VectorialValue::X,
+			VectorialValue::Y, 2));
+	const int cs[3] = { CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID,
+			model.findOrReserveCoordinateSystem(1), model.findOrReserveCoordinateSystem(2) };
+	for (int id = 1; id <= NODE_COUNT; id++) {
+		model.mesh->addNode(id, id, 0.5 * id, 1., cs[id % 3]);
+	}
+	auto start = chrono::steady_clock::now();
+	model.mesh->buildGlobalCoordinates(model);
+	cout << "Transforming " << NODE_COUNT << " nodes to the global frame: " << secondsSince(start)
+			<< " s" << endl;
+
+	start = chrono::steady_clock::now();
+	double maxX = -DBL_MAX;
+	for (int position = 0; position < NODE_COUNT; position++) {
+		maxX = max(maxX, model.mesh->findNode(position, true, &model).x);
+	}
+	cout << "Reading " << NODE_COUNT << " global nodes: " << secondsSince(start) << " s" << endl;
+	BOOST_CHECK(maxX > 0);
+}
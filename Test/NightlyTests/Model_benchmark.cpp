@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Model_benchmark.cpp
+ *
+ * Timings of the Model::finish() passes, checking that they scale linearly
+ * with the size of the model.
+ */
+
+#define BOOST_TEST_MODULE model_benchmark
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include "../../Abstract/ConfigurationParameters.h"
+#include "../../Abstract/Model.h"
+
+using namespace std;
+using namespace vega;
+
+namespace {
+
+/**
+ * Builds a strip of nx QUAD4 cells and a stiffness matrix chaining matrixNodes of its nodes,
+ * then returns the time spent in finish() with only the direct matrix replacement enabled.
+ */
+double timeReplaceDirectMatrices(int nx, int matrixNodes) {
+	Model model("benchmark", "10.3", SolverName::NASTRAN,
+			ModelConfiguration(false, LogLevel::INFO, false, false, false, false, false, false,
+					false, true, false));
+	for (int i = 0; i <= nx; i++) {
+		model.mesh->addNode(i + 1, i, 0., 0.);
+		model.mesh->addNode(nx + i + 2, i, 1., 0.);
+	}
+	CellGroup* cellGroup = model.mesh->createCellGroup("STRIP");
+	for (int i = 0; i < nx; i++) {
+		model.mesh->addCell(i + 1, CellType::QUAD4, {i + 1, i + 2, nx + i + 3, nx + i + 2});
+		cellGroup->addCell(i + 1);
+	}
+	Continuum continuum(model, &ModelType::PLANE_STRESS);
+	continuum.assignCellGroup(cellGroup);
+	model.add(continuum);
+
+	StiffnessMatrix matrix(model);
+	const int step = nx / matrixNodes;
+	for (int i = 0; i + 1 < matrixNodes; i++) {
+		matrix.addStiffness(i * step + 1, DOF::DX, (i + 1) * step + 1, DOF::DX, 1000.);
+	}
+	model.add(matrix);
+
+	auto start = chrono::steady_clock::now();
+	model.finish();
+	const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	BOOST_CHECK_EQUAL(model.filterElements(ElementSet::DISCRETE_1D).size(), static_cast<size_t>(matrixNodes - 1));
+	cout << "replaceDirectMatrices on " << nx << " cells and " << matrixNodes
+			<< " matrix nodes: " << elapsed << " s" << endl;
+	return elapsed;
+}
+
+/**
+ * Fills a symmetric stiffness matrix shaped like a DMIG superelement: a full 6x6 block
+ * on each node and with its next node. Returns the number of coefficients.
+ */
+int fillBandMatrix(StiffnessMatrix& matrix, int nodeCount) {
+	int coefficients = 0;
+	for (int node = 1; node <= nodeCount; node++) {
+		for (int i = 0; i < 6; i++) {
+			for (int j = 0; j < 6; j++) {
+				if (j >= i) {
+					matrix.addComponent(node, DOF::findByPosition(i), node, DOF::findByPosition(j), 1.);
+					coefficients++;
+				}
+				if (node < nodeCount) {
+					matrix.addComponent(node, DOF::findByPosition(i), node + 1, DOF::findByPosition(j), 1.);
+					coefficients++;
+				}
+			}
+		}
+	}
+	return coefficients;
+}
+
+/**
+ * Adds count SPCs and count FORCEs, each one in its own set and in a common set, then returns
+ * the time spent removing them from the model.
+ */
+double timeRemoveConstraintsAndLoadings(int count) {
+	Model model("benchmark", "10.3", SolverName::NASTRAN);
+	LoadSet allLoads(model, LoadSet::LOAD, count + 1);
+	vector<Reference<Constraint>> constraintReferences;
+	vector<Reference<Loading>> loadingReferences;
+	for (int i = 1; i <= count; i++) {
+		model.mesh->addNode(i, i, 0., 0.);
+		SinglePointConstraint spc(model, DOFS::ALL_DOFS);
+		spc.addNodeId(i);
+		model.add(spc);
+		model.addConstraintIntoConstraintSet(spc, ConstraintSet(model, ConstraintSet::SPC, i));
+		model.addConstraintIntoConstraintSet(spc, model.commonConstraintSet);
+		constraintReferences.push_back(spc.getReference());
+		NodalForce force(model, i, 1.);
+		model.add(force);
+		model.addLoadingIntoLoadSet(force, LoadSet(model, LoadSet::LOAD, i));
+		model.addLoadingIntoLoadSet(force, allLoads);
+		loadingReferences.push_back(force.getReference());
+	}
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < count; i++) {
+		model.remove(constraintReferences[i]);
+		model.remove(loadingReferences[i]);
+	}
+	const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	BOOST_CHECK_EQUAL(model.getConstraintsByConstraintSet(model.commonConstraintSet).size(), 0u);
+	BOOST_CHECK_EQUAL(model.getLoadingsByLoadSet(allLoads).size(), 0u);
+	cout << "remove of " << count << " SPCs and FORCEs: " << elapsed << " s" << endl;
+	return elapsed;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_matrix_element ) {
+	Model model("benchmark", "10.3", SolverName::NASTRAN);
+	StiffnessMatrix matrix(model);
+	auto start = chrono::steady_clock::now();
+	const int coefficients = fillBandMatrix(matrix, 2000);
+	const double fill = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	start = chrono::steady_clock::now();
+	double sum = 0;
+	for (int pass = 0; pass < 10; pass++) {
+		for (const auto& nodePair : matrix.nodePairs()) {
+			for (const auto& component : matrix.findSubmatrix(nodePair.first, nodePair.second)) {
+				sum += component.second;
+			}
+		}
+	}
+	const double iterate = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	BOOST_CHECK_EQUAL(sum, 10. * coefficients);
+	cout << "MatrixElement with " << coefficients << " coefficients: filled in " << fill
+			<< " s, 10 iterations in " << iterate << " s" << endl;
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_replace_direct_matrices ) {
+	const double small = timeReplaceDirectMatrices(50000, 2500);
+	const double large = timeReplaceDirectMatrices(200000, 10000);
+	// 4 times bigger in both cells and matrix size: a linear pass takes about 4 times longer,
+	// a pass scanning the cells for each matrix node 16 times longer.
+	BOOST_CHECK_LT(large, 8 * small);
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_remove ) {
+	const double small = timeRemoveConstraintsAndLoadings(25000);
+	const double large = timeRemoveConstraintsAndLoadings(100000);
+	// Each removal only visits the sets holding the object: about 4 times longer.
+	BOOST_CHECK_LT(large, 8 * small);
+}
@@ -162,3 +162,46 @@ BOOST_AUTO_TEST_CASE(test_4a) {
 
 }
 
+
+BOOST_AUTO_TEST_CASE(displacement_in_local_coordinate_system) {
+
+	string testLocation(
+	PROJECT_BASE_DIR "/testdata/nastran/alneos/rbar1mod/rbar1mod.f06");
+	ConfigurationParameters confParams("inputFile", vega::CODE_ASTER, "..", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, testLocation, 0.0003);
+
+	shared_ptr<Model> model(new Model("mname", "unknown", NASTRAN, true));
+	// x along Y, y along -X
+	CartesianCoordinateSystem rotated(*model, VectorialValue(1., 2., 3.), VectorialValue::Y,
+			-1 * VectorialValue::X, 9);
+	model->add(rotated);
+	const int rotatedPosition = model->findOrReserveCoordinateSystem(9);
+	model->mesh->addNode(1, 2, 3, 4);
+	model->mesh->addNode(2, 2, 3, 4);
+	// Node 3 gives its displacements in the rotated system, which has a position but no id 3
+	model->mesh->addNode(3, 2, 3, 4, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, rotatedPosition);
+	model->mesh->addNode(4, 2, 3, 4);
+	model->add(LinearMecaStat(*model, "", 1));
+
+	F06Parser f06parser;
+	f06parser.add_assertions(confParams, model);
+	shared_ptr<LinearMecaStat> linearMecaStat1 = dynamic_pointer_cast<LinearMecaStat>(
+			model->find(Reference<Analysis>(Analysis::LINEAR_MECA_STAT, 1)));
+	BOOST_REQUIRE(linearMecaStat1!=nullptr);
+	map<DOF, double> node3Values;
+	for (auto assertion : linearMecaStat1->getAssertions()) {
+		NodalDisplacementAssertion & nodalDispAssertion =
+				dynamic_cast<NodalDisplacementAssertion&>(*assertion);
+		if (model->mesh->findNode(nodalDispAssertion.nodePosition).id == 3) {
+			node3Values[nodalDispAssertion.dof] = nodalDispAssertion.value;
+		} else if (nodalDispAssertion.dof == DOF::DX
+				&& model->mesh->findNode(nodalDispAssertion.nodePosition).id != 4) {
+			BOOST_CHECK_EQUAL(nodalDispAssertion.value, 4.901961E-01);
+		}
+	}
+	// T1 = 4.901961E-01 in the rotated system
+	BOOST_REQUIRE_EQUAL(node3Values.size(), (size_t) 6);
+	BOOST_CHECK_SMALL(node3Values[DOF::DX], 1e-12);
+	BOOST_CHECK_CLOSE(node3Values[DOF::DY], 4.901961E-01, 1e-9);
+	BOOST_CHECK_SMALL(node3Values[DOF::DZ], 1e-12);
+}
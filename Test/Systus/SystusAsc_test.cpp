@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ */
+
+#define BOOST_TEST_MODULE systus_asc_test
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <stdexcept>
+#include "../../Systus/SystusAsc.h"
+
+using namespace std;
+using namespace vega;
+
+BOOST_AUTO_TEST_CASE( test_systus_matrix_ascii ) {
+	SystusMatrix sm(1, 2, 2);
+	sm.setValue(1, 1, 1, 1, 3.0);
+	sm.setValue(2, 1, 2, 1, -1.5);
+	sm.setValue(1, 2, 1, 2, 4.0);
+	BOOST_CHECK_EQUAL(sm.blocks.size(), 3u);
+	BOOST_CHECK_THROW(sm.setValue(3, 1, 1, 1, 1.0), logic_error);
+	BOOST_CHECK_THROW(sm.setValue(1, 1, 1, 3, 1.0), logic_error);
+
+	// Null blocks are still written, the ASCII format is dense.
+	ostringstream oss;
+	oss << sm;
+	BOOST_CHECK_EQUAL(oss.str(),
+			"0\n1\n2\n2\n16\n0\n0\n1\n2\n"
+			"3 0 0 0 \n"
+			"0 -1.5 0 0 \n"
+			"0 0 4 0 \n"
+			"0 0 0 0 \n");
+}
+
+BOOST_AUTO_TEST_CASE( test_systus_matrix_sparse ) {
+	SystusMatrix sm(7, 3, 50);
+	sm.setValue(50, 2, 3, 1, 2.5);
+	// Only the non-zero block is stored.
+	BOOST_REQUIRE_EQUAL(sm.blocks.size(), 1u);
+	BOOST_CHECK_EQUAL(sm.blocks.begin()->first, 49u + 50u);
+
+	ostringstream oss;
+	oss << sm;
+	istringstream iss(oss.str());
+	string line;
+	// Header, then the list of the nodes
+	for (int i = 0; i < 7 + 50; i++)
+		getline(iss, line);
+	BOOST_CHECK_EQUAL(line, "50");
+	int blockNumber = 0;
+	int nonZeroBlock = -1;
+	while (getline(iss, line)) {
+		if (line != "0 0 0 0 0 0 0 0 0 ") {
+			BOOST_CHECK_EQUAL(line, "0 0 2.5 0 0 0 0 0 0 ");
+			nonZeroBlock = blockNumber;
+		}
+		blockNumber++;
+	}
+	BOOST_CHECK_EQUAL(blockNumber, 50 * 50);
+	BOOST_CHECK_EQUAL(nonZeroBlock, 49 + 50);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ */
+
+#define BOOST_TEST_MODULE systus_writer_test
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include "build_properties.h"
+#include "../../Systus/SystusWriter.h"
+#include "../../Nastran/NastranFacade.h"
+
+using namespace std;
+using namespace vega;
+namespace fs = boost::filesystem;
+
+namespace {
+
+/**
+ * Lines of the file between the line starting with begin and the line starting with end, excluded.
+ */
+vector<string> readSection(const fs::path& path, const string& begin, const string& end) {
+	ifstream in(path.string());
+	vector<string> lines;
+	string line;
+	bool inSection = false;
+	while (getline(in, line)) {
+		if (line.compare(0, end.size(), end) == 0) {
+			break;
+		}
+		if (inSection) {
+			lines.push_back(line);
+		}
+		inSection = inSection || line.compare(0, begin.size(), begin) == 0;
+	}
+	return lines;
+}
+
+string readFile(const fs::path& path) {
+	ifstream in(path.string());
+	ostringstream content;
+	content << in.rdbuf();
+	return content.str();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_nodes_and_elements ) {
+	const fs::path directory = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%");
+	fs::create_directories(directory);
+	ConfigurationParameters configuration(
+			PROJECT_BASE_DIR "/testdata/nastran/alneos/test4a/test4a.dat", SYSTUS, "", "test4a",
+			directory.string());
+	nastran::NastranParser parser;
+	shared_ptr<Model> model = parser.parse(configuration);
+	model->finish();
+	SystusWriter writer;
+	writer.writeModel(model, configuration);
+	const fs::path ascPath = directory / "test4a_SC1_DATA1.ASC";
+	BOOST_REQUIRE(fs::exists(ascPath));
+
+	// Id, constraint code, unused, local vector, loading list, constraint list, coordinates
+	const vector<string> nodes = readSection(ascPath, "BEGIN_NODES", "END_NODES");
+	const vector<string> expectedNodes = { "1 7 0 0 0 0 0 0 0", "2 4 0 0 0 0 1 0 0",
+			"3 0 0 0 0 0 1 1 0", "4 5 0 0 0 0 0 1 0", "5 0 0 0 0 0 0 0 1", "6 0 0 0 0 0 1 0 1",
+			"7 0 0 0 1 0 1 1 1", "8 0 0 0 0 0 0 1 1", "9 0 0 0 0 0 2 3 4" };
+	// The RBE3 adds a node, with an id of its own, at the master
+	BOOST_REQUIRE_EQUAL(nodes.size(), expectedNodes.size() + 1);
+	BOOST_CHECK_EQUAL_COLLECTIONS(nodes.begin(), nodes.begin() + 9, expectedNodes.begin(),
+			expectedNodes.end());
+	BOOST_CHECK_EQUAL(nodes.back().substr(nodes.back().find(' ')), " 0 0 0 0 0 2 3 4");
+
+	// Id, dimension and type with number of nodes, material, loading list, orientation, nodes
+	const vector<string> elements = readSection(ascPath, "BEGIN_ELEMENTS", "END_ELEMENTS");
+	BOOST_REQUIRE_EQUAL(elements.size(), 5u);
+	BOOST_CHECK_EQUAL(elements[0], "1 3008 1 0 0 1 2 3 4 5 6 7 8");
+	const string extraNodeId = nodes.back().substr(0, nodes.back().find(' '));
+	set<string> slaves;
+	for (size_t i = 1; i < elements.size(); i++) {
+		// One RBE3 element per slave: master, slave and the node added by the RBE3
+		istringstream element(elements[i]);
+		string id, type, material, loading, orientation, master, slave, extraNode;
+		element >> id >> type >> material >> loading >> orientation >> master >> slave >> extraNode;
+		BOOST_CHECK_EQUAL(type, "1903");
+		BOOST_CHECK_EQUAL(loading + orientation, "00");
+		BOOST_CHECK_EQUAL(master, "9");
+		BOOST_CHECK_EQUAL(extraNode, extraNodeId);
+		slaves.insert(slave);
+	}
+	BOOST_CHECK(slaves == set<string>({ "2", "3", "6", "7" }));
+	fs::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE( test_shared_sections ) {
+	const fs::path directory = fs::temp_directory_path() / fs::unique_path("vega-%%%%%%%%");
+	const fs::path deckPath = directory / "subcases.dat";
+	fs::create_directories(directory);
+	{
+		// Three subcases: the first two only differ by their load, the last one by its SPC
+		ofstream deck(deckPath.string());
+		deck << "SOL 101\nCEND\nDISPLACEMENT=ALL\n"
+				"SUBCASE 1\nLOAD=1\nSPC=1\n"
+				"SUBCASE 2\nLOAD=2\nSPC=1\n"
+				"SUBCASE 3\nLOAD=1\nSPC=2\n"
+				"BEGIN BULK\n"
+				"GRID,1,,0.,0.,0.\nGRID,2,,1.,0.,0.\nGRID,3,,1.,1.,0.\nGRID,4,,0.,1.,0.\n"
+				"GRID,5,,0.,0.,1.\nGRID,6,,1.,0.,1.\nGRID,7,,1.,1.,1.\nGRID,8,,0.,1.,1.\n"
+				"CHEXA,1,34,1,2,3,4,5,6,+\n+,7,8\n"
+				"SPC1,1,123,1,THRU,4\n"
+				"SPC1,2,123456,1,THRU,4\n"
+				"FORCE,1,7,,1.,0.,0.,-1.\n"
+				"FORCE,2,7,,1.,1.,0.,0.\n"
+				"MAT1,1,210000.,,0.3,7.85-9\n"
+				"PSOLID,34,1\n"
+				"ENDDATA\n";
+	}
+	// Same model, written with and without sharing the sections of the ASC files
+	ConfigurationParameters configuration(deckPath.string(), SYSTUS, "", "subcases",
+			directory.string(), LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02,
+			false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", { { -1 } });
+	nastran::NastranParser parser;
+	shared_ptr<Model> model = parser.parse(configuration);
+	model->finish();
+	for (bool sharedAscSections : { true, false }) {
+		const fs::path outputPath = directory / (sharedAscSections ? "shared" : "unshared");
+		fs::create_directories(outputPath);
+		configuration.outputPath = outputPath.string();
+		SystusWriter writer(sharedAscSections);
+		writer.writeModel(model, configuration);
+	}
+	for (int subcase = 1; subcase <= 3; subcase++) {
+		const string ascName = "subcases_SC" + to_string(subcase) + "_DATA1.ASC";
+		const string shared = readFile(directory / "shared" / ascName);
+		BOOST_CHECK_NE(shared.find("END_GROUPS"), string::npos);
+		// The element section, at least, is copied from the ASC file of another subcase
+		BOOST_CHECK(shared == readFile(directory / "unshared" / ascName));
+	}
+	fs::remove_all(directory);
+}